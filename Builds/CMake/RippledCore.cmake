@@ -509,6 +509,7 @@ target_sources (rippled PRIVATE
   src/ripple/nodestore/backend/NullFactory.cpp
   src/ripple/nodestore/backend/RocksDBFactory.cpp
   src/ripple/nodestore/impl/BatchWriter.cpp
+  src/ripple/nodestore/impl/CodecDictionary.cpp
   src/ripple/nodestore/impl/Database.cpp
   src/ripple/nodestore/impl/DatabaseNodeImp.cpp
   src/ripple/nodestore/impl/DatabaseRotatingImp.cpp
@@ -522,6 +523,7 @@ target_sources (rippled PRIVATE
   src/ripple/nodestore/impl/Shard.cpp
   src/ripple/nodestore/impl/ShardInfo.cpp
   src/ripple/nodestore/impl/TaskQueue.cpp
+  src/ripple/nodestore/impl/TieredCache.cpp
   #[===============================[
      main sources:
        subdir: overlay
@@ -536,6 +538,7 @@ target_sources (rippled PRIVATE
   src/ripple/overlay/impl/PeerSet.cpp
   src/ripple/overlay/impl/ProtocolVersion.cpp
   src/ripple/overlay/impl/TrafficCount.cpp
+  src/ripple/overlay/impl/TransactionVerifier.cpp
   #[===============================[
      main sources:
        subdir: peerfinder
@@ -710,9 +713,11 @@ target_sources (rippled PRIVATE
   src/test/basics/FileUtilities_test.cpp
   src/test/basics/IOUAmount_test.cpp
   src/test/basics/KeyCache_test.cpp
+  src/test/basics/LatencyHistogram_test.cpp
   src/test/basics/PerfLog_test.cpp
   src/test/basics/RangeSet_test.cpp
   src/test/basics/scope_test.cpp
+  src/test/basics/SlabAllocator_test.cpp
   src/test/basics/Slice_test.cpp
   src/test/basics/StringUtilities_test.cpp
   src/test/basics/TaggedCache_test.cpp
@@ -866,6 +871,8 @@ target_sources (rippled PRIVATE
   src/test/overlay/compression_test.cpp
   src/test/overlay/reduce_relay_test.cpp
   src/test/overlay/handshake_test.cpp
+  src/test/overlay/send_queue_test.cpp
+  src/test/overlay/tx_relay_test.cpp
   #[===============================[
      test sources:
        subdir: peerfinder
@@ -891,6 +898,7 @@ target_sources (rippled PRIVATE
   src/test/protocol/Seed_test.cpp
   src/test/protocol/SeqProxy_test.cpp
   src/test/protocol/TER_test.cpp
+  src/test/protocol/VerifyBatch_test.cpp
   src/test/protocol/types_test.cpp
   #[===============================[
      test sources:
@@ -956,6 +964,7 @@ target_sources (rippled PRIVATE
   #]===============================]
   src/test/shamap/FetchPack_test.cpp
   src/test/shamap/SHAMapSync_test.cpp
+  src/test/shamap/SHAMapTraversal_test.cpp
   src/test/shamap/SHAMap_test.cpp
   #[===============================[
      test sources:
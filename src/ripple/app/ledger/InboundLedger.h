@@ -176,6 +176,7 @@ private:
     neededStateHashes(int max, SHAMapSyncFilter* filter) const;
 
     clock_type& m_clock;
+    clock_type::time_point const mStart;
     clock_type::time_point mLastAction;
 
     std::shared_ptr<Ledger> mLedger;
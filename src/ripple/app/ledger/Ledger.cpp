@@ -1121,7 +1121,7 @@ flatFetchTransactions(Application& app, std::vector<uint256>& nodestoreHashes)
         if (obj)
         {
             auto node = SHAMapTreeNode::makeFromPrefix(
-                makeSlice(obj->getData()), SHAMapHash{nodestoreHash});
+                obj->getData(), SHAMapHash{nodestoreHash});
             if (!node)
             {
                 assert(false);
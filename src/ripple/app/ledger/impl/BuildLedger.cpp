@@ -67,7 +67,8 @@ buildLedgerImpl(
         // Write the final version of all modified SHAMap
         // nodes to the node store to preserve the new LCL
 
-        int const asf = built->stateMap().flushDirty(hotACCOUNT_NODE);
+        int const asf = built->stateMap().flushDirty(
+            hotACCOUNT_NODE, app.config().LEDGER_FLUSH_THREADS);
         int const tmf = built->txMap().flushDirty(hotTRANSACTION_NODE);
         JLOG(j.debug()) << "Flushed " << asf << " accounts and " << tmf
                         << " transaction nodes";
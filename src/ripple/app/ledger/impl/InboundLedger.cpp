@@ -85,6 +85,7 @@ InboundLedger::InboundLedger(
           {jtLEDGER_DATA, "InboundLedger", 5},
           app.journal("InboundLedger"))
     , m_clock(clock)
+    , mStart(clock.now())
     , mHaveHeader(false)
     , mHaveState(false)
     , mHaveTransactions(false)
@@ -302,10 +303,10 @@ InboundLedger::tryDB(NodeStore::Database& srcDB)
 {
     if (!mHaveHeader)
     {
-        auto makeLedger = [&, this](Blob const& data) {
+        auto makeLedger = [&, this](Slice data) {
             JLOG(journal_.trace()) << "Ledger header found in fetch pack";
             mLedger = std::make_shared<Ledger>(
-                deserializePrefixedHeader(makeSlice(data)),
+                deserializePrefixedHeader(data),
                 app_.config(),
                 mReason == Reason::SHARD ? *app_.getShardFamily()
                                          : app_.getNodeFamily());
@@ -334,7 +335,8 @@ InboundLedger::tryDB(NodeStore::Database& srcDB)
             auto& dstDB{mLedger->stateMap().family().db()};
             if (std::addressof(dstDB) != std::addressof(srcDB))
             {
-                Blob blob{nodeObject->getData()};
+                auto const data = nodeObject->getData();
+                Blob blob(data.begin(), data.end());
                 dstDB.store(
                     hotLEDGER, std::move(blob), hash_, mLedger->info().seq);
             }
@@ -348,7 +350,7 @@ InboundLedger::tryDB(NodeStore::Database& srcDB)
 
             JLOG(journal_.trace()) << "Ledger header found in fetch pack";
 
-            makeLedger(*data);
+            makeLedger(makeSlice(*data));
             if (failed_)
                 return;
 
@@ -698,8 +700,10 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
 
             // Release the lock while we process the large state map
             sl.unlock();
-            auto nodes =
-                mLedger->stateMap().getMissingNodes(missingNodesFind, &filter);
+            auto nodes = mLedger->stateMap().getMissingNodes(
+                missingNodesFind,
+                &filter,
+                app_.config().LEDGER_FETCH_THREADS);
             sl.lock();
 
             // Make sure nothing happened while we released the lock
@@ -1291,6 +1295,13 @@ InboundLedger::getJson(int)
 
     ret[jss::timeouts] = timeouts_;
 
+    if (auto const elapsed = m_clock.now() - mStart; elapsed > 0s)
+    {
+        // The rate at which useful nodes have arrived so far
+        ret[jss::nodes_per_second] = static_cast<double>(mStats.getGood()) /
+            std::chrono::duration<double>(elapsed).count();
+    }
+
     if (mHaveHeader && !mHaveState)
     {
         Json::Value hv(Json::arrayValue);
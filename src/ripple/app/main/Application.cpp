@@ -413,7 +413,8 @@ public:
         , hashRouter_(std::make_unique<HashRouter>(
               stopwatch(),
               HashRouter::getDefaultHoldTime(),
-              HashRouter::getDefaultRecoverLimit()))
+              HashRouter::getDefaultRecoverLimit(),
+              HashRouter::getDefaultShards()))
 
         , mValidations(
               ValidationParms(),
@@ -449,6 +450,13 @@ public:
     {
         add(m_resourceManager.get());
 
+        m_nodeStore->collectMetrics(m_collectorManager->group("nodestore"));
+        if (shardStore_)
+        {
+            shardStore_->collectMetrics(
+                m_collectorManager->group("shardstore"));
+        }
+
         //
         // VFALCO - READ THIS!
         //
@@ -20,6 +20,7 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/main/DBInit.h>
 #include <ripple/app/rdb/RelationalDBInterface_global.h>
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/StringUtilities.h>
 #include <ripple/basics/contract.h>
@@ -30,6 +31,9 @@
 #include <ripple/core/TimeKeeper.h>
 #include <ripple/json/to_string.h>
 #include <ripple/net/RPCCall.h>
+#include <ripple/nodestore/CodecDictionary.h>
+#include <ripple/nodestore/DummyScheduler.h>
+#include <ripple/nodestore/Manager.h>
 #include <ripple/protocol/BuildInfo.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/RPCHandler.h>
@@ -45,6 +49,7 @@
 #include <boost/program_options.hpp>
 
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <stdexcept>
 #include <utility>
@@ -388,6 +393,11 @@ run(int argc, char** argv)
         "startReporting",
         po::value<std::string>(),
         "Start reporting from a fresh Ledger.")(
+        "train_dictionary",
+        po::value<std::string>(),
+        "Train a compression dictionary from a sample of the node database "
+        "and write it to the specified file. Set compression_dictionary in "
+        "the [node_db] section to the file to embed it in new databases.")(
         "vacuum", "VACUUM the transaction db.")(
         "valid", "Consider the initial ledger a valid network ledger.");
 
@@ -565,6 +575,50 @@ run(int argc, char** argv)
         return 0;
     }
 
+    if (vm.count("train_dictionary"))
+    {
+        // Objects sampled to train the dictionary
+        constexpr std::size_t dictionarySamples = 100000;
+
+        try
+        {
+            // Only read the database; the dictionary being trained may be
+            // the one configured.
+            auto section = config->section(ConfigSection::nodeDatabase());
+            section.set("compression_dictionary", "");
+
+            NodeStore::DummyScheduler scheduler;
+            auto backend = NodeStore::Manager::instance().make_Backend(
+                section,
+                megabytes(4),
+                scheduler,
+                beast::Journal{beast::Journal::getNullSink()});
+            backend->open(false);
+            auto const dict =
+                NodeStore::trainCodecDictionary(*backend, dictionarySamples);
+            backend->close();
+
+            auto const path = vm["train_dictionary"].as<std::string>();
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<char const*>(dict.data()), dict.size());
+            if (!file)
+            {
+                std::cerr << "Unable to write " << path << std::endl;
+                return -1;
+            }
+            std::cout << "Wrote a " << dict.size() << " byte dictionary to "
+                      << path << std::endl;
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "exception " << e.what() << " in function " << __func__
+                      << std::endl;
+            return -1;
+        }
+
+        return 0;
+    }
+
     if (vm.count("start"))
     {
         config->START_UP = Config::FRESH;
@@ -25,6 +25,9 @@ namespace ripple {
 constexpr std::size_t fullBelowTargetSize = 524288;
 constexpr std::chrono::seconds fullBelowExpiration = std::chrono::minutes{10};
 
+// Number of tree node cache entries examined per sweep slice
+constexpr std::size_t treeCacheSweepSlice = 4096;
+
 }  // namespace ripple
 
 #endif
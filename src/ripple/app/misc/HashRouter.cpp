@@ -19,32 +19,60 @@
 
 #include <ripple/app/misc/HashRouter.h>
 
+#include <algorithm>
+
 namespace ripple {
 
+HashRouter::HashRouter(
+    Stopwatch& clock,
+    std::chrono::seconds entryHoldTimeInSeconds,
+    std::uint32_t recoverLimit,
+    std::size_t shards)
+    : holdTime_(entryHoldTimeInSeconds), recoverLimit_(recoverLimit + 1u)
+{
+    assert(shards != 0);
+
+    shards = std::max<std::size_t>(shards, 1);
+    shards_.reserve(shards);
+    while (shards_.size() != shards)
+        shards_.push_back(std::make_unique<Shard>(clock));
+}
+
+auto
+HashRouter::shard(uint256 const& key) -> Shard&
+{
+    if (shards_.size() == 1)
+        return *shards_.front();
+    return *shards_[partitioner_(key) % shards_.size()];
+}
+
 auto
-HashRouter::emplace(uint256 const& key) -> std::pair<Entry&, bool>
+HashRouter::emplace(Shard& shard, uint256 const& key)
+    -> std::pair<Entry&, bool>
 {
-    auto iter = suppressionMap_.find(key);
+    auto& suppressionMap = shard.suppressionMap;
+    auto iter = suppressionMap.find(key);
 
-    if (iter != suppressionMap_.end())
+    if (iter != suppressionMap.end())
     {
-        suppressionMap_.touch(iter);
+        suppressionMap.touch(iter);
         return std::make_pair(std::ref(iter->second), false);
     }
 
-    // See if any supressions need to be expired
-    expire(suppressionMap_, holdTime_);
+    // See if any supressions in this shard need to be expired
+    expire(suppressionMap, holdTime_);
 
     return std::make_pair(
-        std::ref(suppressionMap_.emplace(key, Entry()).first->second), true);
+        std::ref(suppressionMap.emplace(key, Entry()).first->second), true);
 }
 
 void
 HashRouter::addSuppression(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& sh = shard(key);
+    std::lock_guard lock(sh.mutex);
 
-    emplace(key);
+    emplace(sh, key);
 }
 
 bool
@@ -56,9 +84,10 @@ HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer)
 std::pair<bool, std::optional<Stopwatch::time_point>>
 HashRouter::addSuppressionPeerWithStatus(const uint256& key, PeerShortID peer)
 {
-    std::lock_guard lock(mutex_);
+    auto& sh = shard(key);
+    std::lock_guard lock(sh.mutex);
 
-    auto result = emplace(key);
+    auto result = emplace(sh, key);
     result.first.addPeer(peer);
     return {result.second, result.first.relayed()};
 }
@@ -66,9 +95,10 @@ HashRouter::addSuppressionPeerWithStatus(const uint256& key, PeerShortID peer)
 bool
 HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer, int& flags)
 {
-    std::lock_guard lock(mutex_);
+    auto& sh = shard(key);
+    std::lock_guard lock(sh.mutex);
 
-    auto [s, created] = emplace(key);
+    auto [s, created] = emplace(sh, key);
     s.addPeer(peer);
     flags = s.getFlags();
     return created;
@@ -81,21 +111,23 @@ HashRouter::shouldProcess(
     int& flags,
     std::chrono::seconds tx_interval)
 {
-    std::lock_guard lock(mutex_);
+    auto& sh = shard(key);
+    std::lock_guard lock(sh.mutex);
 
-    auto result = emplace(key);
+    auto result = emplace(sh, key);
     auto& s = result.first;
     s.addPeer(peer);
     flags = s.getFlags();
-    return s.shouldProcess(suppressionMap_.clock().now(), tx_interval);
+    return s.shouldProcess(sh.suppressionMap.clock().now(), tx_interval);
 }
 
 int
 HashRouter::getFlags(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& sh = shard(key);
+    std::lock_guard lock(sh.mutex);
 
-    return emplace(key).first.getFlags();
+    return emplace(sh, key).first.getFlags();
 }
 
 bool
@@ -103,9 +135,10 @@ HashRouter::setFlags(uint256 const& key, int flags)
 {
     assert(flags != 0);
 
-    std::lock_guard lock(mutex_);
+    auto& sh = shard(key);
+    std::lock_guard lock(sh.mutex);
 
-    auto& s = emplace(key).first;
+    auto& s = emplace(sh, key).first;
 
     if ((s.getFlags() & flags) == flags)
         return false;
@@ -118,11 +151,12 @@ auto
 HashRouter::shouldRelay(uint256 const& key)
     -> std::optional<std::set<PeerShortID>>
 {
-    std::lock_guard lock(mutex_);
+    auto& sh = shard(key);
+    std::lock_guard lock(sh.mutex);
 
-    auto& s = emplace(key).first;
+    auto& s = emplace(sh, key).first;
 
-    if (!s.shouldRelay(suppressionMap_.clock().now(), holdTime_))
+    if (!s.shouldRelay(sh.suppressionMap.clock().now(), holdTime_))
         return {};
 
     return s.releasePeerSet();
@@ -131,9 +165,10 @@ HashRouter::shouldRelay(uint256 const& key)
 bool
 HashRouter::shouldRecover(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& sh = shard(key);
+    std::lock_guard lock(sh.mutex);
 
-    auto& s = emplace(key).first;
+    auto& s = emplace(sh, key).first;
 
     return s.shouldRecover(recoverLimit_);
 }
@@ -26,7 +26,10 @@
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/container/aged_unordered_map.h>
 
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 namespace ripple {
 
@@ -49,6 +52,12 @@ namespace ripple {
     This table keeps track of which hashes have been received by which peers.
     It is used to manage the routing and broadcasting of messages in the peer
     to peer overlay.
+
+    The table may be split into independently locked shards so that peer
+    threads working on different hashes do not contend. Each shard ages
+    its own entries: expiration is triggered by an insertion into that
+    shard, so with more than one shard an entry may outlive the hold time
+    until its shard next sees a new hash.
 */
 class HashRouter
 {
@@ -164,15 +173,17 @@ public:
         return 1;
     }
 
+    static inline std::size_t
+    getDefaultShards()
+    {
+        return 32;
+    }
+
     HashRouter(
         Stopwatch& clock,
         std::chrono::seconds entryHoldTimeInSeconds,
-        std::uint32_t recoverLimit)
-        : suppressionMap_(clock)
-        , holdTime_(entryHoldTimeInSeconds)
-        , recoverLimit_(recoverLimit + 1u)
-    {
-    }
+        std::uint32_t recoverLimit,
+        std::size_t shards = 1);
 
     HashRouter&
     operator=(HashRouter const&) = delete;
@@ -240,20 +251,46 @@ public:
     bool
     shouldRecover(uint256 const& key);
 
+    /** Returns the number of independently locked shards. */
+    std::size_t
+    shards() const
+    {
+        return shards_.size();
+    }
+
 private:
-    // pair.second indicates whether the entry was created
+    struct Shard
+    {
+        explicit Shard(Stopwatch& clock) : suppressionMap(clock)
+        {
+        }
+
+        std::mutex mutex;
+
+        // Stores the suppressed hashes routed to this shard and their
+        // expiration time
+        beast::aged_unordered_map<
+            uint256,
+            Entry,
+            Stopwatch::clock_type,
+            hardened_hash<strong_hash>>
+            suppressionMap;
+    };
+
+    // Returns the shard responsible for a key
+    Shard&
+    shard(uint256 const& key);
+
+    // pair.second indicates whether the entry was created.
+    // The caller must hold the shard's mutex.
     std::pair<Entry&, bool>
-    emplace(uint256 const&);
+    emplace(Shard& shard, uint256 const& key);
 
-    std::mutex mutable mutex_;
+    // Selects the shard responsible for a key. Seeded independently of
+    // the maps so that keys sharing a shard still spread over its buckets.
+    hardened_hash<strong_hash> partitioner_;
 
-    // Stores all suppressed hashes and their expiration time
-    beast::aged_unordered_map<
-        uint256,
-        Entry,
-        Stopwatch::clock_type,
-        hardened_hash<strong_hash>>
-        suppressionMap_;
+    std::vector<std::unique_ptr<Shard>> shards_;
 
     std::chrono::seconds const holdTime_;
 
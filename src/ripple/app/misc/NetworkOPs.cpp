@@ -281,6 +281,11 @@ public:
         bool bLocal,
         FailHard failType) override;
 
+    void
+    processTransactions(
+        std::vector<std::shared_ptr<Transaction>>& transactions,
+        bool bUnlimited) override;
+
     /**
      * For transactions submitted directly by a client, apply batch of
      * transactions and wait for this transaction to complete.
@@ -562,6 +567,18 @@ public:
     }
 
 private:
+    /**
+     * Checks shared by processTransaction and processTransactions.
+     *
+     * @param transaction Transaction object, which may be canonicalized.
+     * @param rules Rules of the current ledger.
+     * @return true if the transaction should be applied.
+     */
+    bool
+    preProcessTransaction(
+        std::shared_ptr<Transaction>& transaction,
+        Rules const& rules);
+
     void
     setHeartbeatTimer();
     void
@@ -1053,6 +1070,61 @@ NetworkOPsImp::processTransaction(
     FailHard failType)
 {
     auto ev = m_job_queue.makeLoadEvent(jtTXN_PROC, "ProcessTXN");
+
+    if (!preProcessTransaction(
+            transaction, m_ledgerMaster.getCurrentLedger()->rules()))
+        return;
+
+    if (bLocal)
+        doTransactionSync(transaction, bUnlimited, failType);
+    else
+        doTransactionAsync(transaction, bUnlimited, failType);
+}
+
+void
+NetworkOPsImp::processTransactions(
+    std::vector<std::shared_ptr<Transaction>>& transactions,
+    bool bUnlimited)
+{
+    auto ev = m_job_queue.makeLoadEvent(jtTXN_PROC, "ProcessTXNs");
+    auto const rules = m_ledgerMaster.getCurrentLedger()->rules();
+
+    std::vector<std::shared_ptr<Transaction>> accepted;
+    accepted.reserve(transactions.size());
+    for (auto& transaction : transactions)
+    {
+        if (preProcessTransaction(transaction, rules))
+            accepted.push_back(transaction);
+    }
+
+    std::lock_guard lock(mMutex);
+
+    for (auto const& transaction : accepted)
+    {
+        if (transaction->getApplying())
+            continue;
+
+        mTransactions.push_back(TransactionStatus(
+            transaction, bUnlimited, false, FailHard::no));
+        transaction->setApplying();
+    }
+
+    if (mDispatchState == DispatchState::none && !mTransactions.empty())
+    {
+        if (m_job_queue.addJob(jtBATCH, "transactionBatch", [this](Job&) {
+                transactionBatch();
+            }))
+        {
+            mDispatchState = DispatchState::scheduled;
+        }
+    }
+}
+
+bool
+NetworkOPsImp::preProcessTransaction(
+    std::shared_ptr<Transaction>& transaction,
+    Rules const& rules)
+{
     auto const newFlags = app_.getHashRouter().getFlags(transaction->getID());
 
     if ((newFlags & SF_BAD) != 0)
@@ -1060,17 +1132,16 @@ NetworkOPsImp::processTransaction(
         // cached bad
         transaction->setStatus(INVALID);
         transaction->setResult(temBAD_SIGNATURE);
-        return;
+        return false;
     }
 
     // NOTE eahennis - I think this check is redundant,
     // but I'm not 100% sure yet.
     // If so, only cost is looking up HashRouter flags.
-    auto const view = m_ledgerMaster.getCurrentLedger();
     auto const [validity, reason] = checkValidity(
         app_.getHashRouter(),
         *transaction->getSTransaction(),
-        view->rules(),
+        rules,
         app_.config());
     assert(validity == Validity::Valid);
 
@@ -1081,16 +1152,12 @@ NetworkOPsImp::processTransaction(
         transaction->setStatus(INVALID);
         transaction->setResult(temBAD_SIGNATURE);
         app_.getHashRouter().setFlags(transaction->getID(), SF_BAD);
-        return;
+        return false;
     }
 
     // canonicalize can change our pointer
     app_.getMasterTransaction().canonicalize(&transaction);
-
-    if (bLocal)
-        doTransactionSync(transaction, bUnlimited, failType);
-    else
-        doTransactionAsync(transaction, bUnlimited, failType);
+    return true;
 }
 
 void
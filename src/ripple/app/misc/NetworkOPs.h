@@ -139,6 +139,18 @@ public:
         bool bLocal,
         FailHard failType) = 0;
 
+    /**
+     * Process a batch of transactions from the network whose signatures
+     * have been checked. They are queued to be applied together.
+     *
+     * @param transactions Transaction objects, which may be canonicalized
+     * @param bUnlimited Whether the transactions came from a trusted source.
+     */
+    virtual void
+    processTransactions(
+        std::vector<std::shared_ptr<Transaction>>& transactions,
+        bool bUnlimited) = 0;
+
     //--------------------------------------------------------------------------
     //
     // Owner functions
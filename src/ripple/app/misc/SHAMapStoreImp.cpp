@@ -30,6 +30,34 @@
 #include <boost/algorithm/string/predicate.hpp>
 
 namespace ripple {
+SHAMapStoreImp::RateLimiter::RateLimiter(std::uint32_t nodesPerSecond)
+    : interval_(
+          nodesPerSecond ? std::chrono::nanoseconds(
+                               std::chrono::seconds(1)) / nodesPerSecond
+                         : std::chrono::nanoseconds::zero())
+{
+}
+
+void
+SHAMapStoreImp::RateLimiter::acquire(std::size_t count)
+{
+    if (interval_ == std::chrono::nanoseconds::zero())
+        return;
+
+    std::chrono::steady_clock::time_point wake;
+    {
+        // Reserve the next slot, without letting an idle period
+        // build up a burst
+        std::lock_guard lock(mutex_);
+        auto const now = std::chrono::steady_clock::now();
+        if (next_ < now)
+            next_ = now;
+        wake = next_;
+        next_ += interval_ * count;
+    }
+    std::this_thread::sleep_until(wake);
+}
+
 void
 SHAMapStoreImp::SavedStateDB::init(
     BasicConfig const& config,
@@ -140,6 +168,20 @@ SHAMapStoreImp::SHAMapStoreImp(
 
         get_if_exists(section, "advisory_delete", advisoryDelete_);
 
+        // Size of the Bloom filter in front of each rotated backend
+        if (!section.exists("rotating_filter_mb"))
+        {
+            section.set(
+                "rotating_filter_mb",
+                std::to_string(
+                    config.getValueFor(SizedItem::rotatingFilterMB)));
+        }
+
+        get_if_exists(section, "copy_threads", copyThreads_);
+        if (copyThreads_ < 1 || copyThreads_ > 16)
+            Throw<std::runtime_error>("copy_threads must be between 1 and 16");
+        get_if_exists(section, "copy_nodes_per_second", copyNodesPerSecond_);
+
         auto const minInterval = config.standalone()
             ? minimumDeletionIntervalSA_
             : minimumDeletionInterval_;
@@ -191,7 +233,7 @@ SHAMapStoreImp::makeNodeStore(std::int32_t readThreads)
             readThreads,
             std::move(writableBackend),
             std::move(archiveBackend),
-            app_.config().section(ConfigSection::nodeDatabase()),
+            nodeDatabaseSection(),
             app_.logs().journal(nodeStoreName_));
         fdRequired_ += dbr->fdRequired();
         dbRotating_ = dbr.get();
@@ -204,7 +246,7 @@ SHAMapStoreImp::makeNodeStore(std::int32_t readThreads)
                 app_.config().getValueFor(SizedItem::burstSize, std::nullopt)),
             scheduler_,
             readThreads,
-            app_.config().section(ConfigSection::nodeDatabase()),
+            nodeDatabaseSection(),
             app_.logs().journal(nodeStoreName_));
         fdRequired_ += db->fdRequired();
     }
@@ -239,16 +281,52 @@ SHAMapStoreImp::fdRequired() const
 }
 
 bool
-SHAMapStoreImp::copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node)
+SHAMapStoreImp::copyNode(CopyState& state, SHAMapTreeNode const& node)
 {
-    // Copy a single record from node to dbRotating_
-    dbRotating_->fetchNodeObject(node.getHash().as_uint256());
-    if (!(++nodeCount % checkHealthInterval_))
+    // Queue a single record to be copied to dbRotating_
+    std::vector<uint256> batch;
     {
-        if (health())
+        std::lock_guard lock(state.mutex);
+        state.pending.push_back(node.getHash().as_uint256());
+        if (state.pending.size() < copyBatchSize_)
+            return true;
+        batch.swap(state.pending);
+        state.pending.reserve(copyBatchSize_);
+    }
+
+    return copyBatch(state, batch);
+}
+
+bool
+SHAMapStoreImp::copyBatch(CopyState& state, std::vector<uint256> const& batch)
+{
+    {
+        // Wait out a health check on another thread
+        std::lock_guard lock(state.healthMutex);
+        if (state.failed)
             return false;
     }
 
+    state.limiter.acquire(batch.size());
+
+    std::vector<uint256 const*> hashes;
+    hashes.reserve(batch.size());
+    for (auto const& hash : batch)
+        hashes.push_back(&hash);
+    dbRotating_->copyToWritable(hashes);
+
+    auto const before = state.nodeCount.fetch_add(batch.size());
+    if (before / checkHealthInterval_ !=
+        (before + batch.size()) / checkHealthInterval_)
+    {
+        std::lock_guard lock(state.healthMutex);
+        if (state.failed || health())
+        {
+            state.failed = true;
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -346,12 +424,17 @@ SHAMapStoreImp::run()
             }
 
             JLOG(journal_.debug()) << "copying ledger " << validatedSeq;
-            std::uint64_t nodeCount = 0;
-            validatedLedger->stateMap().snapShot(false)->visitNodes(std::bind(
-                &SHAMapStoreImp::copyNode,
-                this,
-                std::ref(nodeCount),
-                std::placeholders::_1));
+            CopyState copyState(copyNodesPerSecond_);
+            validatedLedger->stateMap().snapShot(false)->visitNodes(
+                std::bind(
+                    &SHAMapStoreImp::copyNode,
+                    this,
+                    std::ref(copyState),
+                    std::placeholders::_1),
+                copyThreads_);
+            if (!copyState.pending.empty() && !health())
+                copyBatch(copyState, copyState.pending);
+            std::uint64_t const nodeCount = copyState.nodeCount;
             switch (health())
             {
                 case Health::stopping:
@@ -503,10 +586,19 @@ SHAMapStoreImp::dbPaths()
     }
 }
 
+Section
+SHAMapStoreImp::nodeDatabaseSection() const
+{
+    Section section{app_.config().section(ConfigSection::nodeDatabase())};
+    if (!section.exists("batch_read_threads"))
+        section.set("batch_read_threads", std::to_string(batchReadThreads_));
+    return section;
+}
+
 std::unique_ptr<NodeStore::Backend>
 SHAMapStoreImp::makeBackendRotating(std::string path)
 {
-    Section section{app_.config().section(ConfigSection::nodeDatabase())};
+    Section section{nodeDatabaseSection()};
     boost::filesystem::path newPath;
 
     if (path.size())
@@ -29,7 +29,9 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace ripple {
 
@@ -69,6 +71,46 @@ private:
         setLastRotated(LedgerIndex seq);
     };
 
+    // Limits the rate at which the copy phase of a rotation writes
+    // nodes, so that it doesn't starve the rest of the server of I/O.
+    class RateLimiter
+    {
+    public:
+        // A rate of zero means no limit
+        explicit RateLimiter(std::uint32_t nodesPerSecond);
+
+        // Wait until `count` more nodes may be copied
+        void
+        acquire(std::size_t count);
+
+    private:
+        std::chrono::nanoseconds const interval_;
+        std::mutex mutex_;
+        std::chrono::steady_clock::time_point next_;
+    };
+
+    // Shared by the threads copying the validated state in a rotation
+    struct CopyState
+    {
+        explicit CopyState(std::uint32_t nodesPerSecond)
+            : limiter(nodesPerSecond)
+        {
+        }
+
+        // Hashes waiting to be copied in the next batch
+        std::mutex mutex;
+        std::vector<uint256> pending;
+
+        // Held while a thread checks health, which may sleep. Every
+        // thread waits for it before its next batch.
+        std::mutex healthMutex;
+        // Set once a health check fails, to stop every thread
+        std::atomic<bool> failed{false};
+
+        std::atomic<std::uint64_t> nodeCount{0};
+        RateLimiter limiter;
+    };
+
     Application& app_;
 
     // name of state database
@@ -77,6 +119,11 @@ private:
     std::string const dbPrefix_ = "rippledb";
     // check health/stop status as records are copied
     std::uint64_t const checkHealthInterval_ = 1000;
+    // # of nodes copied to the new backend with each batch write
+    std::size_t const copyBatchSize_ = 256;
+    // NuDB batch read threads for the main node store, unless configured.
+    // Other backends (shards, caches) leave them off.
+    std::size_t const batchReadThreads_ = 4;
     // minimum # of ledgers to maintain for health of network
     static std::uint32_t const minimumDeletionInterval_ = 256;
     // minimum # of ledgers required for standalone mode.
@@ -90,7 +137,7 @@ private:
     SavedStateDB state_db_;
     std::thread thread_;
     bool stop_ = false;
-    bool healthy_ = true;
+    std::atomic<bool> healthy_{true};
     mutable std::condition_variable cond_;
     mutable std::condition_variable rendezvous_;
     mutable std::mutex mutex_;
@@ -104,6 +151,8 @@ private:
     std::uint32_t deleteBatch_ = 100;
     std::chrono::milliseconds backOff_{100};
     std::chrono::seconds ageThreshold_{60};
+    std::size_t copyThreads_ = 1;
+    std::uint32_t copyNodesPerSecond_ = 0;
     /// If set, and the node is out of sync during an
     /// online_delete health check, sleep the thread
     /// for this time and check again so the node can
@@ -178,14 +227,22 @@ public:
     minimumOnline() const override;
 
 private:
-    // callback for visitNodes
+    // callback for visitNodes, called concurrently by the copy threads
     bool
-    copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node);
+    copyNode(CopyState& state, SHAMapTreeNode const& node);
+    // write a batch of nodes to the new backend, then check health
+    bool
+    copyBatch(CopyState& state, std::vector<uint256> const& batch);
     void
     run();
     void
     dbPaths();
 
+    // The [node_db] section, with the defaults that only apply to the
+    // main node store filled in
+    Section
+    nodeDatabaseSection() const;
+
     std::unique_ptr<NodeStore::Backend>
     makeBackendRotating(std::string path = std::string());
 
@@ -229,7 +286,7 @@ private:
     // at next ledger.
     // If recoveryWaitTime_ is set, this may sleep to give rippled
     // time to recover, so never call it from any thread other than
-    // the main "run()".
+    // the main "run()" or the copy threads it starts.
     Health
     health();
 
@@ -26,6 +26,7 @@
 #include <lz4.h>
 #include <stdexcept>
 #include <vector>
+#include <zstd.h>
 
 namespace ripple {
 
@@ -89,23 +90,20 @@ lz4Decompress(
     return decompressedSize;
 }
 
-/** LZ4 block decompression.
+/** Get a contiguous view of the next compressed bytes of a stream.
  * @tparam InputStream ZeroCopyInputStream
  * @param in Input source stream
  * @param inSize Size of compressed data
- * @param decompressed Buffer to hold decompressed data
- * @param decompressedSize Size of the decompressed buffer
- * @return size of the decompressed data
+ * @param compressed Buffer the data is copied to if it spans chunks
+ * @return Pointer to inSize bytes of compressed data
  */
 template <typename InputStream>
-std::size_t
-lz4Decompress(
+std::uint8_t const*
+readCompressed(
     InputStream& in,
     std::size_t inSize,
-    std::uint8_t* decompressed,
-    std::size_t decompressedSize)
+    std::vector<std::uint8_t>& compressed)
 {
-    std::vector<std::uint8_t> compressed;
     std::uint8_t const* chunk = nullptr;
     int chunkSize = 0;
     int copiedInSize = 0;
@@ -147,9 +145,136 @@ lz4Decompress(
 
     if ((copiedInSize == 0 && chunkSize < inSize) ||
         (copiedInSize > 0 && copiedInSize != inSize))
-        Throw<std::runtime_error>("lz4 decompress: insufficient input size");
+        Throw<std::runtime_error>("decompress: insufficient input size");
 
-    return lz4Decompress(chunk, inSize, decompressed, decompressedSize);
+    return chunk;
+}
+
+/** LZ4 block decompression.
+ * @tparam InputStream ZeroCopyInputStream
+ * @param in Input source stream
+ * @param inSize Size of compressed data
+ * @param decompressed Buffer to hold decompressed data
+ * @param decompressedSize Size of the decompressed buffer
+ * @return size of the decompressed data
+ */
+template <typename InputStream>
+std::size_t
+lz4Decompress(
+    InputStream& in,
+    std::size_t inSize,
+    std::uint8_t* decompressed,
+    std::size_t decompressedSize)
+{
+    std::vector<std::uint8_t> compressed;
+    return lz4Decompress(
+        readCompressed(in, inSize, compressed),
+        inSize,
+        decompressed,
+        decompressedSize);
+}
+
+/** Zstandard compression.
+ * @tparam BufferFactory Callable object or lambda.
+ *     Takes the requested buffer size and returns allocated buffer pointer.
+ * @param in Data to compress
+ * @param inSize Size of the data
+ * @param bf Compressed buffer allocator
+ * @param level Compression level
+ * @return Size of compressed data
+ */
+template <typename BufferFactory>
+std::size_t
+zstdCompress(
+    void const* in,
+    std::size_t inSize,
+    BufferFactory&& bf,
+    int level = ZSTD_CLEVEL_DEFAULT)
+{
+    if (inSize > UINT32_MAX)
+        Throw<std::runtime_error>("zstd compress: invalid size");
+
+    auto const outCapacity = ZSTD_compressBound(inSize);
+    auto compressed = bf(outCapacity);
+
+    // Contexts are costly to create and are reused by each thread
+    struct Context
+    {
+        ZSTD_CCtx* const ctx = ZSTD_createCCtx();
+        ~Context()
+        {
+            ZSTD_freeCCtx(ctx);
+        }
+    };
+    thread_local Context const context;
+    if (!context.ctx)
+        Throw<std::runtime_error>("zstd compress: no context");
+
+    auto const compressedSize = ZSTD_compressCCtx(
+        context.ctx, compressed, outCapacity, in, inSize, level);
+    if (ZSTD_isError(compressedSize))
+        Throw<std::runtime_error>("zstd compress: failed");
+
+    return compressedSize;
+}
+
+/**
+ * @param in Compressed data
+ * @param inSize Size of compressed data
+ * @param decompressed Buffer to hold decompressed data
+ * @param decompressedSize Size of the decompressed buffer
+ * @return size of the decompressed data
+ */
+inline std::size_t
+zstdDecompress(
+    std::uint8_t const* in,
+    std::size_t inSize,
+    std::uint8_t* decompressed,
+    std::size_t decompressedSize)
+{
+    struct Context
+    {
+        ZSTD_DCtx* const ctx = ZSTD_createDCtx();
+        ~Context()
+        {
+            ZSTD_freeDCtx(ctx);
+        }
+    };
+    thread_local Context const context;
+    if (!context.ctx)
+        Throw<std::runtime_error>("zstd decompress: no context");
+
+    auto const ret = ZSTD_decompressDCtx(
+        context.ctx, decompressed, decompressedSize, in, inSize);
+
+    if (ZSTD_isError(ret) || ret != decompressedSize)
+        Throw<std::runtime_error>("zstd decompress: failed");
+
+    return decompressedSize;
+}
+
+/** Zstandard decompression.
+ * @tparam InputStream ZeroCopyInputStream
+ * @param in Input source stream
+ * @param inSize Size of compressed data
+ * @param decompressed Buffer to hold decompressed data
+ * @param decompressedSize Size of the decompressed buffer
+ * @return size of the decompressed data
+ */
+template <typename InputStream>
+std::size_t
+zstdDecompress(
+    InputStream& in,
+    std::size_t inSize,
+    std::uint8_t* decompressed,
+    std::size_t decompressedSize)
+{
+    std::vector<std::uint8_t> compressed;
+    return zstdDecompress(
+        readCompressed(in, inSize, compressed),
+        inSize,
+        decompressed,
+        decompressedSize);
 }
 
 }  // namespace compression_algorithms
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_LATENCYHISTOGRAM_H_INCLUDED
+#define RIPPLE_BASICS_LATENCYHISTOGRAM_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace ripple {
+
+/** A histogram of latencies with bounded relative error.
+
+    Values are counted in microseconds. Each power of two range is split
+    into eight equal buckets, so a reported value is never more than
+    12.5% above the latencies it stands for, from one microsecond up to
+    about a day and a half. Longer latencies go in the last bucket.
+
+    Recording is a single relaxed atomic increment and is safe to do
+    from any number of threads.
+*/
+class LatencyHistogram
+{
+    static constexpr std::size_t subBucketBits = 3;
+    static constexpr std::size_t subBuckets = 1 << subBucketBits;
+    static constexpr std::size_t maxExponent = 36;
+
+public:
+    static constexpr std::size_t bucketCount =
+        (maxExponent - subBucketBits + 2) * subBuckets;
+
+    using Counts = std::array<std::uint64_t, bucketCount>;
+
+    /** Count one latency. */
+    void
+    record(std::chrono::microseconds elapsed)
+    {
+        buckets_[bucket(elapsed.count() > 0 ? elapsed.count() : 0)]
+            .fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Return the current counts of every bucket. */
+    Counts
+    snapshot() const
+    {
+        Counts counts;
+        for (std::size_t i = 0; i < bucketCount; ++i)
+            counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        return counts;
+    }
+
+    /** Return the number of latencies in the counts. */
+    static std::uint64_t
+    total(Counts const& counts)
+    {
+        std::uint64_t n = 0;
+        for (auto const c : counts)
+            n += c;
+        return n;
+    }
+
+    /** Return the latency below which the given percent of the counts lie.
+
+        The result is the largest latency of the bucket holding that
+        percentile, or zero if nothing was counted.
+    */
+    static std::chrono::microseconds
+    percentile(Counts const& counts, double percent)
+    {
+        auto const n = total(counts);
+        if (n == 0)
+            return {};
+
+        auto const rank = std::max<std::uint64_t>(
+            1, static_cast<std::uint64_t>(std::ceil(n * percent / 100)));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucketCount; ++i)
+        {
+            seen += counts[i];
+            if (seen >= rank)
+                return highest(i);
+        }
+        return highest(bucketCount - 1);
+    }
+
+    /** Return the counts recorded after the earlier snapshot was taken. */
+    static Counts
+    since(Counts const& now, Counts const& earlier)
+    {
+        Counts counts;
+        for (std::size_t i = 0; i < bucketCount; ++i)
+            counts[i] = now[i] - earlier[i];
+        return counts;
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, bucketCount> buckets_{};
+
+    static std::size_t
+    bucket(std::uint64_t us)
+    {
+        if (us < 2 * subBuckets)
+            return us;
+
+        std::size_t exponent = 0;
+        for (auto v = us; v > 1; v >>= 1)
+            ++exponent;
+        if (exponent > maxExponent)
+            return bucketCount - 1;
+
+        auto const shift = exponent - subBucketBits;
+        return shift * subBuckets + (us >> shift);
+    }
+
+    // The largest latency counted in the bucket
+    static std::chrono::microseconds
+    highest(std::size_t index)
+    {
+        if (index < 2 * subBuckets)
+            return std::chrono::microseconds(index);
+
+        auto const shift = index / subBuckets - 1;
+        auto const mantissa = index % subBuckets + subBuckets;
+        return std::chrono::microseconds(((mantissa + 1) << shift) - 1);
+    }
+};
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,280 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_SLABALLOCATOR_H_INCLUDED
+#define RIPPLE_BASICS_SLABALLOCATOR_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+/** Statistics describing the use of the allocator.
+
+    Allocation and deallocation counts are gathered when a thread
+    exchanges chunks with the depot, so they may lag behind by up to
+    a magazine's worth of operations per thread.
+*/
+struct SlabAllocatorStats
+{
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t slabs = 0;
+    std::uint64_t reservedBytes = 0;
+};
+
+/** Allocator for fixed size chunks of memory.
+
+    Chunks are carved from large slabs which are never returned to the
+    system; freed chunks are kept for reuse by later allocations of the same
+    size, which keeps heavy churn from fragmenting the general purpose heap.
+
+    Every thread keeps a small "magazine" of free chunks, so allocating and
+    freeing normally touch only thread local state. A thread exchanges half
+    a magazine with the shared depot (under a mutex) only when its magazine
+    runs empty or overflows, and returns everything when it exits.
+
+    Each distinct set of template arguments is an independent allocator.
+
+    @tparam ChunkSize The size, in bytes, of each allocation.
+    @tparam SlabSize The size, in bytes, of the slabs chunks are carved from.
+    @tparam MagazineSize The number of chunks moved between a thread and the
+                         depot at a time.
+*/
+template <
+    std::size_t ChunkSize,
+    std::size_t SlabSize,
+    std::size_t MagazineSize = 64>
+class SlabAllocator
+{
+    static_assert(ChunkSize >= sizeof(void*), "Chunks are too small");
+    static_assert(
+        ChunkSize % alignof(void*) == 0,
+        "Chunks would not be suitably aligned");
+    static_assert(SlabSize >= ChunkSize, "Slabs must hold at least one chunk");
+    static_assert(MagazineSize > 0, "Magazines must hold at least one chunk");
+
+public:
+    SlabAllocator() = delete;
+
+    /** Return an uninitialized chunk of `ChunkSize` bytes. */
+    [[nodiscard]] static void*
+    allocate()
+    {
+        if (retired())
+            return allocateFromDepot();
+
+        auto& m = magazine();
+        if (m.count == 0)
+            refill(m);
+        ++m.allocations;
+        return m.chunks[--m.count];
+    }
+
+    /** Return a chunk previously obtained from allocate(). */
+    static void
+    deallocate(void* p)
+    {
+        assert(owns(p));
+        if (retired())
+            return deallocateToDepot(p);
+
+        auto& m = magazine();
+        if (m.count == m.chunks.size())
+            drain(m, MagazineSize);
+        ++m.deallocations;
+        m.chunks[m.count++] = p;
+    }
+
+    /** Return `true` if `p` was carved from one of this allocator's slabs.
+
+        @note This is a linear search and only intended for assertions.
+    */
+    static bool
+    owns(void const* p)
+    {
+        auto& d = depot();
+        auto const addr = reinterpret_cast<std::uintptr_t>(p);
+        std::lock_guard lock(d.mutex);
+        return std::any_of(d.slabs.begin(), d.slabs.end(), [&](auto const& s) {
+            auto const begin = reinterpret_cast<std::uintptr_t>(s.get());
+            return addr >= begin && addr < begin + SlabSize;
+        });
+    }
+
+    static SlabAllocatorStats
+    stats()
+    {
+        auto& d = depot();
+        SlabAllocatorStats s;
+        s.allocations = d.allocations.load(std::memory_order_relaxed);
+        s.deallocations = d.deallocations.load(std::memory_order_relaxed);
+        {
+            std::lock_guard lock(d.mutex);
+            s.slabs = d.slabs.size();
+        }
+        s.reservedBytes = s.slabs * SlabSize;
+        return s;
+    }
+
+private:
+    static constexpr std::size_t chunksPerSlab = SlabSize / ChunkSize;
+
+    struct Depot
+    {
+        std::mutex mutex;
+        std::vector<void*> chunks;
+        std::vector<std::unique_ptr<std::uint8_t[]>> slabs;
+
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> deallocations{0};
+    };
+
+    struct Magazine
+    {
+        // Twice the exchange size, so a thread alternating between
+        // allocating and freeing does not bounce off the depot.
+        std::array<void*, 2 * MagazineSize> chunks;
+        std::size_t count = 0;
+
+        std::uint64_t allocations = 0;
+        std::uint64_t deallocations = 0;
+
+        Magazine() = default;
+        Magazine(Magazine const&) = delete;
+        Magazine&
+        operator=(Magazine const&) = delete;
+
+        ~Magazine()
+        {
+            drain(*this, count);
+            retired() = true;
+        }
+    };
+
+    // The depot is never destroyed, so chunks may still be freed while
+    // objects with static storage duration are being destroyed.
+    static Depot&
+    depot()
+    {
+        static Depot& d = *new Depot;
+        return d;
+    }
+
+    // Set once the calling thread's magazine has been destroyed. Any later
+    // requests from the thread go directly to the depot.
+    static bool&
+    retired()
+    {
+        thread_local bool r = false;
+        return r;
+    }
+
+    static Magazine&
+    magazine()
+    {
+        thread_local Magazine m;
+        return m;
+    }
+
+    // Lock must be held
+    static void
+    publish(Depot& d, Magazine& m)
+    {
+        d.allocations.fetch_add(m.allocations, std::memory_order_relaxed);
+        d.deallocations.fetch_add(m.deallocations, std::memory_order_relaxed);
+        m.allocations = 0;
+        m.deallocations = 0;
+    }
+
+    // Lock must be held
+    static void
+    addSlab(Depot& d)
+    {
+        std::unique_ptr<std::uint8_t[]> slab(new std::uint8_t[SlabSize]);
+        d.chunks.reserve(d.chunks.size() + chunksPerSlab);
+        for (std::size_t i = chunksPerSlab; i-- > 0;)
+            d.chunks.push_back(slab.get() + i * ChunkSize);
+        d.slabs.push_back(std::move(slab));
+    }
+
+    static void*
+    allocateFromDepot()
+    {
+        auto& d = depot();
+        std::lock_guard lock(d.mutex);
+        if (d.chunks.empty())
+            addSlab(d);
+        d.allocations.fetch_add(1, std::memory_order_relaxed);
+        auto const p = d.chunks.back();
+        d.chunks.pop_back();
+        return p;
+    }
+
+    static void
+    deallocateToDepot(void* p)
+    {
+        auto& d = depot();
+        std::lock_guard lock(d.mutex);
+        d.deallocations.fetch_add(1, std::memory_order_relaxed);
+        d.chunks.push_back(p);
+    }
+
+    static void
+    refill(Magazine& m)
+    {
+        assert(m.count == 0);
+        auto& d = depot();
+        std::lock_guard lock(d.mutex);
+        publish(d, m);
+
+        if (d.chunks.size() < MagazineSize)
+            addSlab(d);
+
+        auto const n = std::min(MagazineSize, d.chunks.size());
+        std::copy(d.chunks.end() - n, d.chunks.end(), m.chunks.begin());
+        d.chunks.resize(d.chunks.size() - n);
+        m.count = n;
+    }
+
+    static void
+    drain(Magazine& m, std::size_t n)
+    {
+        assert(n <= m.count);
+        auto& d = depot();
+        std::lock_guard lock(d.mutex);
+        publish(d, m);
+        d.chunks.insert(
+            d.chunks.end(),
+            m.chunks.begin() + (m.count - n),
+            m.chunks.begin() + m.count);
+        m.count -= n;
+    }
+};
+
+}  // namespace ripple
+
+#endif
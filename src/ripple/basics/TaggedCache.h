@@ -25,6 +25,8 @@
 #include <ripple/basics/hardened_hash.h>
 #include <ripple/beast/clock/abstract_clock.h>
 #include <ripple/beast/insight/Insight.h>
+#include <array>
+#include <atomic>
 #include <functional>
 #include <mutex>
 #include <vector>
@@ -40,6 +42,12 @@ namespace ripple {
     If it stays in memory even after it is ejected from the cache,
     the map will track it.
 
+    The key space may be striped across several partitions, each with its
+    own lock, so that threads working on different keys rarely contend.
+    Each partition is aged and swept independently against its share of
+    the target size. With a single partition (the default) the whole cache
+    is guarded by one lock, which callers may hold through peekMutex().
+
     @note Callers must not modify data objects that are stored in the cache
           unless they hold their own lock over all cache operations.
 */
@@ -48,9 +56,12 @@ template <
     class T,
     class Hash = hardened_hash<>,
     class KeyEqual = std::equal_to<Key>,
-    class Mutex = std::recursive_mutex>
+    class Mutex = std::recursive_mutex,
+    std::size_t Partitions = 1>
 class TaggedCache
 {
+    static_assert(Partitions > 0, "TaggedCache needs at least one partition");
+
 public:
     using mutex_type = Mutex;
     using key_type = Key;
@@ -75,9 +86,6 @@ public:
         , m_name(name)
         , m_target_size(size)
         , m_target_age(expiration)
-        , m_cache_count(0)
-        , m_hits(0)
-        , m_misses(0)
     {
     }
 
@@ -89,22 +97,34 @@ public:
         return m_clock;
     }
 
+    /** Return the number of independently locked partitions. */
+    static constexpr std::size_t
+    partitions()
+    {
+        return Partitions;
+    }
+
     int
     getTargetSize() const
     {
-        std::lock_guard lock(m_mutex);
         return m_target_size;
     }
 
     void
     setTargetSize(int s)
     {
-        std::lock_guard lock(m_mutex);
         m_target_size = s;
 
         if (s > 0)
-            m_cache.rehash(static_cast<std::size_t>(
-                (s + (s >> 2)) / m_cache.max_load_factor() + 1));
+        {
+            auto const share = partitionShare(s);
+            for (auto& p : m_partitions)
+            {
+                std::lock_guard lock(p.mutex);
+                p.cache.rehash(static_cast<std::size_t>(
+                    (share + (share >> 2)) / p.cache.max_load_factor() + 1));
+            }
+        }
 
         JLOG(m_journal.debug()) << m_name << " target size set to " << s;
     }
@@ -112,57 +132,71 @@ public:
     clock_type::duration
     getTargetAge() const
     {
-        std::lock_guard lock(m_mutex);
         return m_target_age;
     }
 
     void
     setTargetAge(clock_type::duration s)
     {
-        std::lock_guard lock(m_mutex);
         m_target_age = s;
         JLOG(m_journal.debug())
-            << m_name << " target age set to " << m_target_age.count();
+            << m_name << " target age set to " << s.count();
     }
 
     int
     getCacheSize() const
     {
-        std::lock_guard lock(m_mutex);
-        return m_cache_count;
+        int count = 0;
+        for (auto const& p : m_partitions)
+        {
+            std::lock_guard lock(p.mutex);
+            count += p.cache_count;
+        }
+        return count;
     }
 
     int
     getTrackSize() const
     {
-        std::lock_guard lock(m_mutex);
-        return m_cache.size();
+        std::size_t size = 0;
+        for (auto const& p : m_partitions)
+        {
+            std::lock_guard lock(p.mutex);
+            size += p.cache.size();
+        }
+        return size;
     }
 
     float
     getHitRate()
     {
-        std::lock_guard lock(m_mutex);
-        auto const total = static_cast<float>(m_hits + m_misses);
-        return m_hits * (100.0f / std::max(1.0f, total));
+        auto const [hits, misses] = getHitsAndMisses();
+        auto const total = static_cast<float>(hits + misses);
+        return hits * (100.0f / std::max(1.0f, total));
     }
 
     void
     clear()
     {
-        std::lock_guard lock(m_mutex);
-        m_cache.clear();
-        m_cache_count = 0;
+        for (auto& p : m_partitions)
+        {
+            std::lock_guard lock(p.mutex);
+            p.cache.clear();
+            p.cache_count = 0;
+        }
     }
 
     void
     reset()
     {
-        std::lock_guard lock(m_mutex);
-        m_cache.clear();
-        m_cache_count = 0;
-        m_hits = 0;
-        m_misses = 0;
+        for (auto& p : m_partitions)
+        {
+            std::lock_guard lock(p.mutex);
+            p.cache.clear();
+            p.cache_count = 0;
+            p.hits = 0;
+            p.misses = 0;
+        }
     }
 
     void
@@ -170,95 +204,65 @@ public:
     {
         int cacheRemovals = 0;
         int mapRemovals = 0;
-        int cc = 0;
 
-        // Keep references to all the stuff we sweep
-        // so that we can destroy them outside the lock.
-        //
-        std::vector<std::shared_ptr<mapped_type>> stuffToSweep;
+        for (auto& p : m_partitions)
+            sweepPartition(p, cacheRemovals, mapRemovals);
 
+        if (mapRemovals || cacheRemovals)
         {
-            clock_type::time_point const now(m_clock.now());
-            clock_type::time_point when_expire;
-
-            std::lock_guard lock(m_mutex);
+            JLOG(m_journal.trace())
+                << m_name << ": cache = " << getTrackSize() << "-"
+                << cacheRemovals << ", map-=" << mapRemovals;
+        }
+    }
 
-            if (m_target_size == 0 ||
-                (static_cast<int>(m_cache.size()) <= m_target_size))
-            {
-                when_expire = now - m_target_age;
-            }
-            else
-            {
-                when_expire =
-                    now - m_target_age * m_target_size / m_cache.size();
-
-                clock_type::duration const minimumAge(std::chrono::seconds(1));
-                if (when_expire > (now - minimumAge))
-                    when_expire = now - minimumAge;
-
-                JLOG(m_journal.trace())
-                    << m_name << " is growing fast " << m_cache.size() << " of "
-                    << m_target_size << " aging at "
-                    << (now - when_expire).count() << " of "
-                    << m_target_age.count();
-            }
+    /** Sweep a bounded slice of the cache.
 
-            stuffToSweep.reserve(m_cache.size());
+        Examines roughly `budget` entries, resuming where the previous call
+        stopped. A full sweep can then be spread over many short calls, and
+        no partition lock is held for longer than it takes to examine the
+        slice.
 
-            auto cit = m_cache.begin();
+        @param budget The number of entries to examine.
+        @return `true` if this call completed a pass over the whole cache.
+    */
+    bool
+    sweepSlice(std::size_t budget)
+    {
+        int cacheRemovals = 0;
+        int mapRemovals = 0;
+        bool cycled = false;
 
-            while (cit != m_cache.end())
+        {
+            std::lock_guard lock(m_sweep_mutex);
+            std::size_t examined = 0;
+            do
             {
-                if (cit->second.isWeak())
+                bool finished = false;
+                examined += sweepBuckets(
+                    m_partitions[m_sweep_partition],
+                    budget - examined,
+                    finished,
+                    cacheRemovals,
+                    mapRemovals);
+
+                if (finished && ++m_sweep_partition == Partitions)
                 {
-                    // weak
-                    if (cit->second.isExpired())
-                    {
-                        ++mapRemovals;
-                        cit = m_cache.erase(cit);
-                    }
-                    else
-                    {
-                        ++cit;
-                    }
+                    m_sweep_partition = 0;
+                    cycled = true;
+                    break;
                 }
-                else if (cit->second.last_access <= when_expire)
-                {
-                    // strong, expired
-                    --m_cache_count;
-                    ++cacheRemovals;
-                    if (cit->second.ptr.unique())
-                    {
-                        stuffToSweep.push_back(cit->second.ptr);
-                        ++mapRemovals;
-                        cit = m_cache.erase(cit);
-                    }
-                    else
-                    {
-                        // remains weakly cached
-                        cit->second.ptr.reset();
-                        ++cit;
-                    }
-                }
-                else
-                {
-                    // strong, not expired
-                    ++cc;
-                    ++cit;
-                }
-            }
+            } while (examined < budget);
         }
 
         if (mapRemovals || cacheRemovals)
         {
             JLOG(m_journal.trace())
-                << m_name << ": cache = " << m_cache.size() << "-"
-                << cacheRemovals << ", map-=" << mapRemovals;
+                << m_name << ": slice, cache-=" << cacheRemovals
+                << ", map-=" << mapRemovals;
         }
 
-        // At this point stuffToSweep will go out of scope outside the lock
-        // and decrement the reference count on each strong pointer.
+        return cycled;
     }
 
     bool
@@ -266,11 +270,12 @@ public:
     {
         // Remove from cache, if !valid, remove from map too. Returns true if
         // removed from cache
-        std::lock_guard lock(m_mutex);
+        auto& p = partition(key);
+        std::lock_guard lock(p.mutex);
 
-        auto cit = m_cache.find(key);
+        auto cit = p.cache.find(key);
 
-        if (cit == m_cache.end())
+        if (cit == p.cache.end())
             return false;
 
         Entry& entry = cit->second;
@@ -279,13 +284,13 @@ public:
 
         if (entry.isCached())
         {
-            --m_cache_count;
+            --p.cache_count;
             entry.ptr.reset();
             ret = true;
         }
 
         if (!valid || entry.isExpired())
-            m_cache.erase(cit);
+            p.cache.erase(cit);
 
         return ret;
     }
@@ -315,17 +320,18 @@ private:
     {
         // Return canonical value, store if needed, refresh in cache
         // Return values: true=we had the data already
-        std::lock_guard lock(m_mutex);
+        auto& p = partition(key);
+        std::lock_guard lock(p.mutex);
 
-        auto cit = m_cache.find(key);
+        auto cit = p.cache.find(key);
 
-        if (cit == m_cache.end())
+        if (cit == p.cache.end())
         {
-            m_cache.emplace(
+            p.cache.emplace(
                 std::piecewise_construct,
                 std::forward_as_tuple(key),
                 std::forward_as_tuple(m_clock.now(), data));
-            ++m_cache_count;
+            ++p.cache_count;
             return false;
         }
 
@@ -362,13 +368,13 @@ private:
                 data = cachedData;
             }
 
-            ++m_cache_count;
+            ++p.cache_count;
             return true;
         }
 
         entry.ptr = data;
         entry.weak_ptr = data;
-        ++m_cache_count;
+        ++p.cache_count;
 
         return false;
     }
@@ -392,13 +398,14 @@ public:
     fetch(const key_type& key)
     {
         // fetch us a shared pointer to the stored data object
-        std::lock_guard lock(m_mutex);
+        auto& p = partition(key);
+        std::lock_guard lock(p.mutex);
 
-        auto cit = m_cache.find(key);
+        auto cit = p.cache.find(key);
 
-        if (cit == m_cache.end())
+        if (cit == p.cache.end())
         {
-            ++m_misses;
+            ++p.misses;
             return {};
         }
 
@@ -407,7 +414,7 @@ public:
 
         if (entry.isCached())
         {
-            ++m_hits;
+            ++p.hits;
             return entry.ptr;
         }
 
@@ -416,12 +423,12 @@ public:
         if (entry.isCached())
         {
             // independent of cache size, so not counted as a hit
-            ++m_cache_count;
+            ++p.cache_count;
             return entry.ptr;
         }
 
-        m_cache.erase(cit);
-        ++m_misses;
+        p.cache.erase(cit);
+        ++p.misses;
         return {};
     }
 
@@ -465,9 +472,10 @@ public:
         bool found = false;
 
         // If present, make current in cache
-        std::lock_guard lock(m_mutex);
+        auto& p = partition(key);
+        std::lock_guard lock(p.mutex);
 
-        if (auto cit = m_cache.find(key); cit != m_cache.end())
+        if (auto cit = p.cache.find(key); cit != p.cache.end())
         {
             Entry& entry = cit->second;
 
@@ -479,7 +487,7 @@ public:
                 if (entry.isCached())
                 {
                     // We just put the object back in cache
-                    ++m_cache_count;
+                    ++p.cache_count;
                     entry.touch(m_clock.now());
                     found = true;
                 }
@@ -487,7 +495,7 @@ public:
                 {
                     // Couldn't get strong pointer,
                     // object fell out of the cache so remove the entry.
-                    m_cache.erase(cit);
+                    p.cache.erase(cit);
                 }
             }
             else
@@ -501,10 +509,17 @@ public:
         return found;
     }
 
+    /** Return the lock which guards the entire cache.
+
+        @note Only available when the cache has a single partition.
+    */
     mutex_type&
     peekMutex()
     {
-        return m_mutex;
+        static_assert(
+            Partitions == 1,
+            "A partitioned TaggedCache has no single mutex");
+        return m_partitions[0].mutex;
     }
 
     std::vector<key_type>
@@ -512,10 +527,11 @@ public:
     {
         std::vector<key_type> v;
 
+        for (auto const& p : m_partitions)
         {
-            std::lock_guard lock(m_mutex);
-            v.reserve(m_cache.size());
-            for (auto const& _ : m_cache)
+            std::lock_guard lock(p.mutex);
+            v.reserve(v.size() + p.cache.size());
+            for (auto const& _ : p.cache)
                 v.push_back(_.first);
         }
 
@@ -523,6 +539,196 @@ public:
     }
 
 private:
+    class Entry;
+    struct Partition;
+
+    // The share of the target size allotted to each partition
+    static int
+    partitionShare(int size)
+    {
+        return (size + static_cast<int>(Partitions) - 1) /
+            static_cast<int>(Partitions);
+    }
+
+    Partition&
+    partition(key_type const& key)
+    {
+        if constexpr (Partitions == 1)
+            return m_partitions[0];
+        else
+            return m_partitions[m_partitioner(key) % Partitions];
+    }
+
+    std::pair<std::uint64_t, std::uint64_t>
+    getHitsAndMisses() const
+    {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        for (auto const& p : m_partitions)
+        {
+            std::lock_guard lock(p.mutex);
+            hits += p.hits;
+            misses += p.misses;
+        }
+        return {hits, misses};
+    }
+
+    // Return the access time at or before which a strongly cached entry
+    // of the partition expires. Lock must be held.
+    clock_type::time_point
+    expiration(Partition const& p, clock_type::time_point const& now) const
+    {
+        int const targetSize = partitionShare(m_target_size);
+        clock_type::duration const targetAge = m_target_age;
+
+        if (targetSize == 0 || (static_cast<int>(p.cache.size()) <= targetSize))
+            return now - targetAge;
+
+        auto when_expire = now - targetAge * targetSize / p.cache.size();
+
+        clock_type::duration const minimumAge(std::chrono::seconds(1));
+        if (when_expire > (now - minimumAge))
+            when_expire = now - minimumAge;
+
+        JLOG(m_journal.trace())
+            << m_name << " is growing fast " << p.cache.size() << " of "
+            << targetSize << " aging at " << (now - when_expire).count()
+            << " of " << targetAge.count();
+
+        return when_expire;
+    }
+
+    void
+    sweepPartition(Partition& p, int& cacheRemovals, int& mapRemovals)
+    {
+        // Keep references to all the stuff we sweep
+        // so that we can destroy them outside the lock.
+        //
+        std::vector<std::shared_ptr<mapped_type>> stuffToSweep;
+
+        {
+            clock_type::time_point const now(m_clock.now());
+
+            std::lock_guard lock(p.mutex);
+
+            auto const when_expire = expiration(p, now);
+
+            stuffToSweep.reserve(p.cache.size());
+
+            auto cit = p.cache.begin();
+
+            while (cit != p.cache.end())
+            {
+                if (cit->second.isWeak())
+                {
+                    // weak
+                    if (cit->second.isExpired())
+                    {
+                        ++mapRemovals;
+                        cit = p.cache.erase(cit);
+                    }
+                    else
+                    {
+                        ++cit;
+                    }
+                }
+                else if (cit->second.last_access <= when_expire)
+                {
+                    // strong, expired
+                    --p.cache_count;
+                    ++cacheRemovals;
+                    if (cit->second.ptr.unique())
+                    {
+                        stuffToSweep.push_back(cit->second.ptr);
+                        ++mapRemovals;
+                        cit = p.cache.erase(cit);
+                    }
+                    else
+                    {
+                        // remains weakly cached
+                        cit->second.ptr.reset();
+                        ++cit;
+                    }
+                }
+                else
+                {
+                    // strong, not expired
+                    ++cit;
+                }
+            }
+        }
+
+        // At this point stuffToSweep will go out of scope outside the lock
+        // and decrement the reference count on each strong pointer.
+    }
+
+    // Sweep whole buckets of the partition, starting at its sweep cursor,
+    // until `budget` entries have been examined or the partition has been
+    // covered. Returns the number of entries examined.
+    std::size_t
+    sweepBuckets(
+        Partition& p,
+        std::size_t budget,
+        bool& finished,
+        int& cacheRemovals,
+        int& mapRemovals)
+    {
+        std::vector<std::shared_ptr<mapped_type>> stuffToSweep;
+        std::size_t examined = 0;
+
+        {
+            clock_type::time_point const now(m_clock.now());
+
+            std::lock_guard lock(p.mutex);
+
+            auto const when_expire = expiration(p, now);
+
+            // Buckets are stable until the map is rehashed, which
+            // only happens on insertion, so erase after the walk.
+            std::vector<key_type> toErase;
+            auto const buckets = p.cache.bucket_count();
+            while (p.sweep_bucket < buckets && examined < budget)
+            {
+                auto const n = p.sweep_bucket++;
+                for (auto it = p.cache.begin(n); it != p.cache.end(n); ++it)
+                {
+                    ++examined;
+                    Entry& entry = it->second;
+                    if (entry.isWeak())
+                    {
+                        if (entry.isExpired())
+                            toErase.push_back(it->first);
+                    }
+                    else if (entry.last_access <= when_expire)
+                    {
+                        --p.cache_count;
+                        ++cacheRemovals;
+                        if (entry.ptr.unique())
+                        {
+                            stuffToSweep.push_back(std::move(entry.ptr));
+                            toErase.push_back(it->first);
+                        }
+                        else
+                        {
+                            // remains weakly cached
+                            entry.ptr.reset();
+                        }
+                    }
+                }
+            }
+
+            for (auto const& key : toErase)
+                p.cache.erase(key);
+            mapRemovals += toErase.size();
+
+            finished = p.sweep_bucket >= buckets;
+            if (finished)
+                p.sweep_bucket = 0;
+        }
+
+        return examined;
+    }
+
     void
     collect_metrics()
     {
@@ -531,10 +737,10 @@ private:
         {
             beast::insight::Gauge::value_type hit_rate(0);
             {
-                std::lock_guard lock(m_mutex);
-                auto const total(m_hits + m_misses);
+                auto const [hits, misses] = getHitsAndMisses();
+                auto const total(hits + misses);
                 if (total != 0)
-                    hit_rate = (m_hits * 100) / total;
+                    hit_rate = (hits * 100) / total;
             }
             m_stats.hit_rate.set(hit_rate);
         }
@@ -602,26 +808,42 @@ private:
 
     using cache_type = hardened_hash_map<key_type, Entry, Hash, KeyEqual>;
 
+    // An independently locked slice of the key space
+    struct Partition
+    {
+        mutex_type mutable mutex;
+
+        // Number of items cached
+        int cache_count = 0;
+        cache_type cache;  // Hold strong reference to recent objects
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+
+        // Next bucket examined by sweepSlice
+        std::size_t sweep_bucket = 0;
+    };
+
     beast::Journal m_journal;
     clock_type& m_clock;
     Stats m_stats;
 
-    mutex_type mutable m_mutex;
-
     // Used for logging
     std::string m_name;
 
     // Desired number of cache entries (0 = ignore)
-    int m_target_size;
+    std::atomic<int> m_target_size;
 
     // Desired maximum cache age
-    clock_type::duration m_target_age;
+    std::atomic<clock_type::duration> m_target_age;
+
+    // Selects the partition responsible for a key
+    Hash m_partitioner;
+
+    std::array<Partition, Partitions> m_partitions;
 
-    // Number of items cached
-    int m_cache_count;
-    cache_type m_cache;  // Hold strong reference to recent objects
-    std::uint64_t m_hits;
-    std::uint64_t m_misses;
+    // Serializes sweepSlice and guards its position
+    std::mutex m_sweep_mutex;
+    std::size_t m_sweep_partition = 0;
 };
 
 }  // namespace ripple
@@ -57,7 +57,8 @@ enum class SizedItem : std::size_t {
     lgrDBCache,
     openFinalLimit,
     burstSize,
-    ramSizeGB
+    ramSizeGB,
+    rotatingFilterMB
 };
 
 //  This entire derived class is deprecated.
@@ -204,6 +205,12 @@ public:
     // Thread pool configuration
     std::size_t WORKERS = 0;
 
+    // Threads used to flush the state map of a newly built ledger
+    std::size_t LEDGER_FLUSH_THREADS = 1;
+
+    // Threads used to find missing state map nodes while acquiring a ledger
+    std::size_t LEDGER_FETCH_THREADS = 1;
+
     // Reduce-relay - these parameters are experimental.
     // Enable reduce-relay features
     // Validation/proposal reduce-relay feature
@@ -61,6 +61,8 @@ struct ConfigSection
 #define SECTION_INSIGHT "insight"
 #define SECTION_IPS "ips"
 #define SECTION_IPS_FIXED "ips_fixed"
+#define SECTION_LEDGER_FETCH_THREADS "ledger_fetch_threads"
+#define SECTION_LEDGER_FLUSH_THREADS "ledger_flush_threads"
 #define SECTION_LEDGER_HISTORY "ledger_history"
 #define SECTION_MAX_TRANSACTIONS "max_transactions"
 #define SECTION_NETWORK_QUORUM "network_quorum"
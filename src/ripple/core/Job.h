@@ -53,6 +53,7 @@ enum JobType {
     jtUPDATE_PF,      // Update pathfinding requests
     jtTRANSACTION,    // A transaction received from the network
     jtBATCH,          // Apply batched transactions
+    jtCOMPRESS,       // Compress a large message for peers
     jtADVANCE,        // Advance validated/acquired ledgers
     jtPUBLEDGER,      // Publish a fully-accepted ledger
     jtTXN_DATA,       // Fetch a proposed set
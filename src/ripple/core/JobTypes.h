@@ -67,6 +67,7 @@ private:
         add(jtUPDATE_PF, "updatePaths", maxLimit, false, 0ms, 0ms);
         add(jtTRANSACTION, "transaction", maxLimit, false, 250ms, 1000ms);
         add(jtBATCH, "batch", maxLimit, false, 250ms, 1000ms);
+        add(jtCOMPRESS, "compressMessage", maxLimit, false, 0ms, 0ms);
         add(jtADVANCE, "advanceLedger", maxLimit, false, 0ms, 0ms);
         add(jtPUBLEDGER, "publishNewLedger", maxLimit, false, 3000ms, 4500ms);
         add(jtTXN_DATA, "fetchTxnData", 1, false, 0ms, 0ms);
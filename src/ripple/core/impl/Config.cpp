@@ -108,7 +108,7 @@ namespace ripple {
 
 // clang-format off
 // The configurable node sizes are "tiny", "small", "medium", "large", "huge"
-inline constexpr std::array<std::pair<SizedItem, std::array<int, 5>>, 12>
+inline constexpr std::array<std::pair<SizedItem, std::array<int, 5>>, 13>
 sizedItems
 {{
     // FIXME: We should document each of these items, explaining exactly
@@ -128,6 +128,7 @@ sizedItems
     {SizedItem::openFinalLimit,  {{      8,      16,      32,      64,      128 }}},
     {SizedItem::burstSize,       {{      4,       8,      16,      32,       48 }}},
     {SizedItem::ramSizeGB,       {{      8,      12,      16,      24,       32 }}},
+    {SizedItem::rotatingFilterMB,{{      8,      16,      32,      64,      128 }}},
 }};
 
 // Ensure that the order of entries in the table corresponds to the
@@ -630,6 +631,24 @@ Config::loadFromString(std::string const& fileContents)
     if (getSingleSection(secConfig, SECTION_WORKERS, strTemp, j_))
         WORKERS = beast::lexicalCastThrow<std::size_t>(strTemp);
 
+    if (getSingleSection(secConfig, SECTION_LEDGER_FLUSH_THREADS, strTemp, j_))
+    {
+        LEDGER_FLUSH_THREADS = beast::lexicalCastThrow<std::size_t>(strTemp);
+        if (LEDGER_FLUSH_THREADS < 1 || LEDGER_FLUSH_THREADS > 16)
+            Throw<std::runtime_error>(
+                "Invalid value specified in [" SECTION_LEDGER_FLUSH_THREADS
+                "] section; the value must be between 1 and 16");
+    }
+
+    if (getSingleSection(secConfig, SECTION_LEDGER_FETCH_THREADS, strTemp, j_))
+    {
+        LEDGER_FETCH_THREADS = beast::lexicalCastThrow<std::size_t>(strTemp);
+        if (LEDGER_FETCH_THREADS < 1 || LEDGER_FETCH_THREADS > 16)
+            Throw<std::runtime_error>(
+                "Invalid value specified in [" SECTION_LEDGER_FETCH_THREADS
+                "] section; the value must be between 1 and 16");
+    }
+
     if (getSingleSection(secConfig, SECTION_COMPRESSION, strTemp, j_))
         COMPRESSION = beast::lexicalCastThrow<bool>(strTemp);
 
@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_CODECDICTIONARY_H_INCLUDED
+#define RIPPLE_NODESTORE_CODECDICTIONARY_H_INCLUDED
+
+#include <ripple/basics/Blob.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/nodestore/Backend.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace ripple {
+namespace NodeStore {
+
+/** A zstd dictionary trained on node objects.
+
+    Small objects such as ledger entries compress poorly on their own
+    because each one is too short to build up any history. A dictionary
+    trained offline from a sample of the store supplies that history,
+    so the repetitive field codes and common values compress away.
+
+    A backend that uses a dictionary embeds it in the store under
+    @ref codecDictionaryKey, so the objects written with it can always
+    be decoded, whatever the configuration later says.
+*/
+class CodecDictionary
+{
+public:
+    /** The default size of a trained dictionary, in bytes. */
+    static constexpr std::size_t defaultCapacity = 112 * 1024;
+
+    /** Create a dictionary from its serialized form.
+
+        @throws std::runtime_error if the data is not a zstd dictionary.
+    */
+    explicit CodecDictionary(Blob data);
+
+    CodecDictionary(CodecDictionary const&) = delete;
+    CodecDictionary&
+    operator=(CodecDictionary const&) = delete;
+
+    ~CodecDictionary();
+
+    /** The identifier stored with every object compressed with this. */
+    std::uint32_t
+    id() const
+    {
+        return id_;
+    }
+
+    /** The serialized dictionary, as embedded in a store. */
+    Blob const&
+    data() const
+    {
+        return data_;
+    }
+
+    /** The largest output compress() can produce for `size` bytes. */
+    static std::size_t
+    compressBound(std::size_t size);
+
+    /** Compress using this dictionary.
+
+        @return The number of bytes written to `out`.
+        @throws std::runtime_error on failure.
+    */
+    std::size_t
+    compress(void const* in, std::size_t inSize, void* out, std::size_t outMax)
+        const;
+
+    /** Decompress data produced by compress().
+
+        @return The number of bytes written to `out`.
+        @throws std::runtime_error on failure.
+    */
+    std::size_t
+    decompress(
+        void const* in,
+        std::size_t inSize,
+        void* out,
+        std::size_t outSize) const;
+
+    /** Train a dictionary from sample objects.
+
+        @param samples The encoded objects to train from.
+        @param capacity The maximum size of the dictionary.
+        @throws std::runtime_error if training fails, which usually
+                means there were too few samples.
+    */
+    static Blob
+    train(std::vector<Blob> const& samples, std::size_t capacity);
+
+private:
+    Blob const data_;
+    std::uint32_t id_;
+    ZSTD_CDict_s* cdict_ = nullptr;
+    ZSTD_DDict_s* ddict_ = nullptr;
+};
+
+/** The key under which a backend embeds its dictionary.
+
+    This is "ZSTDDICT" in ASCII followed by zeroes; it can never collide
+    with the hash of a node object in practice.
+*/
+uint256 const&
+codecDictionaryKey();
+
+/** Train a dictionary from a random sample of the objects in a backend.
+
+    Inner nodes are skipped since the codec stores them as bare hashes.
+
+    @param backend An open backend to sample.
+    @param maxSamples The largest number of objects to sample.
+    @param capacity The maximum size of the dictionary.
+*/
+Blob
+trainCodecDictionary(
+    Backend& backend,
+    std::size_t maxSamples,
+    std::size_t capacity = CodecDictionary::defaultCapacity);
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
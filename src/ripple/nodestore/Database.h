@@ -21,13 +21,16 @@
 #define RIPPLE_NODESTORE_DATABASE_H_INCLUDED
 
 #include <ripple/basics/KeyCache.h>
+#include <ripple/basics/LatencyHistogram.h>
 #include <ripple/basics/TaggedCache.h>
+#include <ripple/beast/insight/Insight.h>
 #include <ripple/nodestore/Backend.h>
 #include <ripple/nodestore/NodeObject.h>
 #include <ripple/nodestore/Scheduler.h>
 #include <ripple/protocol/SystemParameters.h>
 
 #include <condition_variable>
+#include <optional>
 #include <thread>
 
 namespace ripple {
@@ -57,15 +60,22 @@ public:
     /** Construct the node store.
 
         @param scheduler The scheduler to use for performing asynchronous tasks.
-        @param readThreads The number of asynchronous read threads to create.
+        @param readThreads The minimum number of asynchronous read threads.
+                           More are started, up to `read_threads_max`, when
+                           reads queue up faster than they are served.
         @param config The configuration settings
         @param journal Destination for logging output.
+        @param readThreadIdleTimeout How long read threads above the
+                                     minimum wait for work before they
+                                     exit. Only tests should set this.
     */
     Database(
         Scheduler& scheduler,
         int readThreads,
         Section const& config,
-        beast::Journal j);
+        beast::Journal j,
+        std::optional<std::chrono::milliseconds> readThreadIdleTimeout =
+            std::nullopt);
 
     /** Destroy the node store.
         All pending operations are completed, pending writes flushed,
@@ -208,9 +218,19 @@ public:
         return fetchSz_;
     }
 
-    void
+    virtual void
     getCountsJson(Json::Value& obj);
 
+    /** Report metrics of the asynchronous reads and of fetch latency.
+
+        The number of read threads and pending reads are reported as gauges,
+        and the time reads wait in the queue as an event. The median, 99th
+        percentile and largest latency of the fetches and stores since the
+        previous collection are reported as gauges.
+    */
+    void
+    collectMetrics(beast::insight::Collector::ptr const& collector);
+
     /** Returns the number of file descriptors the database expects to need */
     int
     fdRequired() const
@@ -348,6 +368,22 @@ protected:
         fetchDurationUs_ += duration;
     }
 
+    // Called by the store functions with the time a single store took
+    void
+    updateStoreLatency(std::chrono::steady_clock::duration elapsed)
+    {
+        storeLatency_.record(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed));
+    }
+
+    // Called with the time a Backend::storeBatch call took
+    void
+    updateStoreBatchLatency(std::chrono::steady_clock::duration elapsed)
+    {
+        storeBatchLatency_.record(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed));
+    }
+
 private:
     std::atomic<std::uint64_t> storeCount_{0};
     std::atomic<std::uint64_t> storeSz_{0};
@@ -355,29 +391,149 @@ private:
     std::atomic<std::uint64_t> fetchDurationUs_{0};
     std::atomic<std::uint64_t> storeDurationUs_{0};
 
+    // Latency of each synchronous fetch, of each single-object async
+    // fetch, and of each batch fetched by the async read threads.
+    LatencyHistogram fetchSyncLatency_;
+    LatencyHistogram fetchAsyncLatency_;
+    LatencyHistogram readBatchLatency_;
+
+    // Latency of each single-object store and of each batch store. Only
+    // the backend call is timed, so for a backend that writes in the
+    // background, such as RocksDB, this is the time to queue the write.
+    // A rotating database keeps one set of histograms for both its
+    // writable and archive backends.
+    LatencyHistogram storeLatency_;
+    LatencyHistogram storeBatchLatency_;
+
+    // Number of batches fetched by the async read threads,
+    // and the number of objects requested by those batches
+    std::atomic<std::uint64_t> readBatchCount_{0};
+    std::atomic<std::uint64_t> readBatchObjects_{0};
+
+    // Read threads above the minimum exit after being idle this long
+    static constexpr std::chrono::seconds defaultReadThreadIdleTimeout{30};
+
+    // A read thread is started when the running ones would take longer
+    // than this to work through the queue at the observed latency
+    static constexpr std::chrono::milliseconds readQueueTarget{10};
+
+    struct Stats
+    {
+        template <class Handler>
+        Stats(
+            Handler const& handler,
+            beast::insight::Collector::ptr const& collector)
+            : hook(collector->make_hook(handler))
+            , readThreads(collector->make_gauge("read_threads"))
+            , readQueue(collector->make_gauge("read_queue"))
+            , readQueueWait(collector->make_event("read_queue_wait"))
+            , fetchSync(collector, "fetch_sync")
+            , fetchAsync(collector, "fetch_async")
+            , readBatch(collector, "read_batch")
+            , store(collector, "store")
+            , storeBatch(collector, "store_batch")
+        {
+        }
+
+        // Percentiles of the latencies recorded since the last collection
+        struct Latency
+        {
+            Latency(
+                beast::insight::Collector::ptr const& collector,
+                std::string const& name)
+                : p50(collector->make_gauge(name + "_p50_us"))
+                , p99(collector->make_gauge(name + "_p99_us"))
+                , max(collector->make_gauge(name + "_max_us"))
+            {
+                last.fill(0);
+            }
+
+            void
+            set(LatencyHistogram const& histogram);
+
+            LatencyHistogram::Counts last;
+            beast::insight::Gauge p50;
+            beast::insight::Gauge p99;
+            beast::insight::Gauge max;
+        };
+
+        beast::insight::Hook hook;
+        beast::insight::Gauge readThreads;
+        beast::insight::Gauge readQueue;
+        beast::insight::Event readQueueWait;
+        Latency fetchSync;
+        Latency fetchAsync;
+        Latency readBatch;
+        Latency store;
+        Latency storeBatch;
+    };
+
+    using ReadCallbacks = std::vector<std::pair<
+        std::uint32_t,
+        std::function<void(std::shared_ptr<NodeObject> const&)>>>;
+
+    struct ReadRequest
+    {
+        // When the first request for the hash was queued
+        std::chrono::steady_clock::time_point queued;
+        ReadCallbacks callbacks;
+    };
+
     mutable std::mutex readLock_;
     std::condition_variable readCondVar_;
 
     // reads to do
-    std::map<
-        uint256,
-        std::vector<std::pair<
-            std::uint32_t,
-            std::function<void(std::shared_ptr<NodeObject> const&)>>>>
-        read_;
+    std::map<uint256, ReadRequest> read_;
 
     // last read
     uint256 readLastHash_;
 
+    // largest number of distinct pending reads observed
+    std::size_t readQueueMax_{0};
+
     std::vector<std::thread> readThreads_;
     bool readStopping_{false};
 
+    int const readThreadsMin_;
+    int const readThreadsMax_;
+    std::chrono::milliseconds const readThreadIdleTimeout_;
+
+    // Running read threads and how many of them are waiting for work
+    int readThreadCount_{0};
+    int readThreadsIdle_{0};
+
+    // Read threads that exited and have yet to be joined
+    std::vector<std::thread::id> readThreadsFinished_;
+
+    // Moving average of the time taken to fetch a batch of reads
+    std::atomic<std::uint64_t> readBatchDurationUs_{0};
+
+    std::shared_ptr<Stats> stats_;
+
     virtual std::shared_ptr<NodeObject>
     fetchNodeObject(
         uint256 const& hash,
         std::uint32_t ledgerSeq,
         FetchReport& fetchReport) = 0;
 
+    /** Fetch several objects stored in the same database.
+
+        The default implementation fetches the objects one at a time.
+        Databases with a single backend for a given ledger sequence
+        should override this to issue one Backend::fetchBatch.
+
+        @note Fetch statistics are updated by the caller.
+        @param hashes The keys of the objects to retrieve.
+        @param ledgerSeq The sequence of the ledger where the objects
+                are stored.
+        @return The objects, in the order of `hashes`. Objects that couldn't
+                be retrieved are `nullptr`.
+    */
+    virtual std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256 const*> const& hashes,
+        std::uint32_t ledgerSeq);
+
     /** Visit every object in the database
         This is usually called during import.
 
@@ -401,6 +557,15 @@ private:
 
     void
     threadEntry();
+
+    // Start a read thread, joining any that have exited
+    // Lock over readLock_ required
+    void
+    startReadThread(std::lock_guard<std::mutex> const&);
+
+    // Update the insight gauges
+    void
+    collect();
 };
 
 }  // namespace NodeStore
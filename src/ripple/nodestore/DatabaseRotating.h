@@ -49,6 +49,18 @@ public:
     virtual void
     rotateWithLock(std::function<std::unique_ptr<NodeStore::Backend>(
                        std::string const& writableBackendName)> const& f) = 0;
+
+    /** Copies objects into the writable backend.
+
+        Objects that are only in the archive backend are written to the
+        writable backend with a single batch.
+
+        @note This can be called concurrently.
+        @param hashes The keys of the objects to copy.
+        @return The number of objects found in either backend.
+    */
+    virtual std::size_t
+    copyToWritable(std::vector<uint256 const*> const& hashes) = 0;
 };
 
 }  // namespace NodeStore
@@ -255,6 +255,14 @@ public:
     virtual Json::Value
     getDatabaseImportStatus() const = 0;
 
+    /** Query the progress of the shards being finalized
+
+        @return An array holding the progress and throughput of every
+                shard in the finalizing state
+    */
+    [[nodiscard]] virtual Json::Value
+    getFinalizeStatus() const = 0;
+
     /** Returns the first ledger sequence of the shard currently being imported
         from the NodeStore
 
@@ -22,8 +22,11 @@
 
 #include <ripple/basics/Blob.h>
 #include <ripple/basics/CountedObject.h>
+#include <ripple/basics/Slice.h>
 #include <ripple/protocol/Protocol.h>
 
+#include <memory>
+
 // VFALCO NOTE Intentionally not in the NodeStore namespace
 
 namespace ripple {
@@ -42,6 +45,10 @@ enum NodeObjectType : std::uint32_t {
     the blob. The blob is a variable length block of serialized data. The
     type identifies what the blob contains.
 
+    The blob is either owned by the object or is a slice of a larger,
+    reference counted buffer (for example, the buffer a backend
+    decompressed the object into) which the object keeps alive.
+
     @note No checking is performed to make sure the hash matches the data.
     @see SHAMap
 */
@@ -67,6 +74,14 @@ public:
         uint256 const& hash,
         PrivateAccess);
 
+    // This constructor is private, use createObject instead.
+    NodeObject(
+        NodeObjectType type,
+        std::shared_ptr<void const> owner,
+        Slice data,
+        uint256 const& hash,
+        PrivateAccess);
+
     /** Create an object from fields.
 
         The caller's variable is modified during this call. The
@@ -81,6 +96,23 @@ public:
     static std::shared_ptr<NodeObject>
     createObject(NodeObjectType type, Blob&& data, uint256 const& hash);
 
+    /** Create an object that references data held elsewhere.
+
+        No copy of the data is made.
+
+        @param type The type of object.
+        @param owner The buffer holding the payload. It is kept alive for
+                     as long as the object is.
+        @param data The payload, which must lie within `owner`.
+        @param hash The 256-bit hash of the payload data.
+    */
+    static std::shared_ptr<NodeObject>
+    createObject(
+        NodeObjectType type,
+        std::shared_ptr<void const> owner,
+        Slice data,
+        uint256 const& hash);
+
     /** Returns the type of this object. */
     NodeObjectType
     getType() const;
@@ -90,13 +122,15 @@ public:
     getHash() const;
 
     /** Returns the underlying data. */
-    Blob const&
+    Slice
     getData() const;
 
 private:
     NodeObjectType const mType;
     uint256 const mHash;
-    Blob const mData;
+    Blob const mBlob;
+    std::shared_ptr<void const> const mOwner;
+    Slice const mData;
 };
 
 }  // namespace ripple
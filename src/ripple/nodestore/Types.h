@@ -37,7 +37,12 @@ enum {
     // in a batch. Actual usage can be twice this since
     // we have a new batch growing as we write the old.
     //
-    batchWriteLimitSize = 65536
+    batchWriteLimitSize = 65536,
+
+    // This sets a limit on the number of deferred reads
+    // an async read thread fetches from the backend at once.
+    //
+    asyncReadBatchLimit = 256
 };
 
 /** Return codes from Backend operations. */
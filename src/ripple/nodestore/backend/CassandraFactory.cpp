@@ -560,21 +560,27 @@ public:
             return backendError;
         }
 
-        nudb::detail::buffer bf;
+        SharedBufferFactory bf;
         std::pair<void const*, std::size_t> uncompressed =
             nodeobject_decompress(buf, bufSize, bf);
         DecodedBlob decoded(key, uncompressed.first, uncompressed.second);
-        cass_result_free(res);
 
         if (!decoded.wasOk())
         {
+            cass_result_free(res);
             pno->reset();
             JLOG(j_.error()) << "Cassandra error decoding result: " << rc
                              << ", " << cass_error_desc(rc);
             ++counters_.readErrors;
             return dataCorrupt;
         }
-        *pno = decoded.createObject();
+        // Uncompressed values point into the result, so those are copied
+        // before it is freed.
+        if (auto buffer = bf.release())
+            *pno = decoded.createObject(std::move(buffer));
+        else
+            *pno = decoded.createObject();
+        cass_result_free(res);
         return ok;
     }
 
@@ -884,15 +890,15 @@ readCallback(CassFuture* fut, void* cbData)
             finish();
             return;
         }
-        nudb::detail::buffer bf;
+        SharedBufferFactory bf;
         std::pair<void const*, std::size_t> uncompressed =
             nodeobject_decompress(buf, bufSize, bf);
         DecodedBlob decoded(
             requestParams.key, uncompressed.first, uncompressed.second);
-        cass_result_free(res);
 
         if (!decoded.wasOk())
         {
+            cass_result_free(res);
             JLOG(requestParams.backend.j_.fatal())
                 << "Cassandra fetch error - data corruption : " << rc << ", "
                 << cass_error_desc(rc);
@@ -900,7 +906,13 @@ readCallback(CassFuture* fut, void* cbData)
             finish();
             return;
         }
-        requestParams.result = decoded.createObject();
+        // Uncompressed values point into the result, so those are copied
+        // before it is freed.
+        if (auto buffer = bf.release())
+            requestParams.result = decoded.createObject(std::move(buffer));
+        else
+            requestParams.result = decoded.createObject();
+        cass_result_free(res);
         finish();
     }
 }
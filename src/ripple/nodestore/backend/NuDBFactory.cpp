@@ -18,6 +18,8 @@
 //==============================================================================
 
 #include <ripple/basics/contract.h>
+#include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/nodestore/CodecDictionary.h>
 #include <ripple/nodestore/Factory.h>
 #include <ripple/nodestore/Manager.h>
 #include <ripple/nodestore/impl/DecodedBlob.h>
@@ -25,12 +27,21 @@
 #include <ripple/nodestore/impl/codec.h>
 #include <boost/filesystem.hpp>
 #include <cassert>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <deque>
 #include <exception>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <nudb/nudb.hpp>
+#include <thread>
 
 namespace ripple {
 namespace NodeStore {
@@ -44,14 +55,59 @@ public:
     /* "SHRD" in ASCII */
     static constexpr std::uint64_t deterministicType = 0x5348524400000000ull;
 
+    /* Default number of threads servicing fetchBatch lookups. Off unless
+       configured, since shard stores and caches open many backends. */
+    static constexpr std::size_t defaultBatchReadThreads = 0;
+
+    /* Batches smaller than this are fetched on the calling thread */
+    static constexpr std::size_t minParallelBatch = 4;
+
+    // A fetchBatch request shared between the calling thread and
+    // the batch read threads. Lookups are claimed one at a time
+    // through `next`, so every thread stays busy until the batch
+    // is exhausted.
+    //
+    // A reader may still hold the batch after the caller has returned,
+    // so the batch keeps its own copy of the keys and never touches the
+    // caller's vector. Keys are only dereferenced once claimed, and the
+    // caller waits for every claimed lookup to finish.
+    struct BatchRead
+    {
+        std::vector<uint256 const*> const hashes;
+        std::size_t const count;
+        std::vector<std::shared_ptr<NodeObject>> results;
+        std::atomic<std::size_t> next{0};
+
+        // Protected by batchMutex_
+        std::size_t finished{0};
+        std::exception_ptr error;
+
+        explicit BatchRead(std::vector<uint256 const*> const& h)
+            : hashes(h), count(h.size()), results(h.size())
+        {
+        }
+    };
+
     beast::Journal const j_;
     size_t const keyBytes_;
     std::size_t const burstSize_;
     std::string const name_;
+    std::string const dictionaryPath_;
     nudb::store db_;
     std::atomic<bool> deletePath_;
     Scheduler& scheduler_;
 
+    std::size_t const batchReadThreads_;
+    std::vector<std::thread> batchReaders_;
+    std::mutex batchMutex_;
+    std::condition_variable batchCond_;
+    std::condition_variable batchDoneCond_;
+    std::deque<std::shared_ptr<BatchRead>> batchQueue_;
+    bool batchStop_{false};
+
+    // Set when the store is opened and left alone until it is closed
+    std::shared_ptr<CodecDictionary const> dictionary_;
+
     NuDBBackend(
         size_t keyBytes,
         Section const& keyValues,
@@ -62,8 +118,14 @@ public:
         , keyBytes_(keyBytes)
         , burstSize_(burstSize)
         , name_(get<std::string>(keyValues, "path"))
+        , dictionaryPath_(
+              get<std::string>(keyValues, "compression_dictionary"))
         , deletePath_(false)
         , scheduler_(scheduler)
+        , batchReadThreads_(get<std::size_t>(
+              keyValues,
+              "batch_read_threads",
+              defaultBatchReadThreads))
     {
         if (name_.empty())
             Throw<std::runtime_error>(
@@ -81,9 +143,15 @@ public:
         , keyBytes_(keyBytes)
         , burstSize_(burstSize)
         , name_(get<std::string>(keyValues, "path"))
+        , dictionaryPath_(
+              get<std::string>(keyValues, "compression_dictionary"))
         , db_(context)
         , deletePath_(false)
         , scheduler_(scheduler)
+        , batchReadThreads_(get<std::size_t>(
+              keyValues,
+              "batch_read_threads",
+              defaultBatchReadThreads))
     {
         if (name_.empty())
             Throw<std::runtime_error>(
@@ -152,6 +220,10 @@ public:
             (db_.appnum() & deterministicMask) != deterministicType)
             Throw<std::runtime_error>("nodestore: unknown appnum");
         db_.set_burst(burstSize_);
+        // Deterministic shards must be identical on every server,
+        // so they never take on a configured dictionary.
+        openDictionary(db_.appnum() == currentType);
+        startBatchReaders();
     }
 
     bool
@@ -169,6 +241,8 @@ public:
     void
     close() override
     {
+        stopBatchReaders();
+        dictionary_.reset();
         if (db_.is_open())
         {
             nudb::error_code ec;
@@ -190,16 +264,23 @@ public:
         nudb::error_code ec;
         db_.fetch(
             key,
-            [key, pno, &status](void const* data, std::size_t size) {
-                nudb::detail::buffer bf;
-                auto const result = nodeobject_decompress(data, size, bf);
+            [key, pno, &status, dict = dictionary_.get()](
+                void const* data, std::size_t size) {
+                SharedBufferFactory bf;
+                auto const result =
+                    nodeobject_decompress(data, size, bf, dict);
                 DecodedBlob decoded(key, result.first, result.second);
                 if (!decoded.wasOk())
                 {
                     status = dataCorrupt;
                     return;
                 }
-                *pno = decoded.createObject();
+                // Uncompressed values point into NuDB's buffer, which is
+                // only valid during this call, so those are copied.
+                if (auto buffer = bf.release())
+                    *pno = decoded.createObject(std::move(buffer));
+                else
+                    *pno = decoded.createObject();
                 status = ok;
             },
             ec);
@@ -213,19 +294,51 @@ public:
     std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
     fetchBatch(std::vector<uint256 const*> const& hashes) override
     {
-        std::vector<std::shared_ptr<NodeObject>> results;
-        results.reserve(hashes.size());
-        for (auto const& h : hashes)
+        if (batchReaders_.empty() || hashes.size() < minParallelBatch)
         {
-            std::shared_ptr<NodeObject> nObj;
-            Status status = fetch(h->begin(), &nObj);
-            if (status != ok)
-                results.push_back({});
-            else
-                results.push_back(nObj);
+            std::vector<std::shared_ptr<NodeObject>> results;
+            results.reserve(hashes.size());
+            for (auto const& h : hashes)
+            {
+                std::shared_ptr<NodeObject> nObj;
+                Status status = fetch(h->begin(), &nObj);
+                if (status != ok)
+                    results.push_back({});
+                else
+                    results.push_back(nObj);
+            }
+
+            return {results, ok};
         }
 
-        return {results, ok};
+        // Issue the lookups (and the decompression that follows each
+        // one) concurrently, so the batch costs roughly one device
+        // round trip instead of one per key.
+        auto br = std::make_shared<BatchRead>(hashes);
+        {
+            std::lock_guard lock(batchMutex_);
+            batchQueue_.push_back(br);
+        }
+        auto const helpers = std::min(batchReaders_.size(), hashes.size() - 1);
+        for (std::size_t i = 0; i < helpers; ++i)
+            batchCond_.notify_one();
+
+        doBatchRead(*br);
+
+        {
+            std::unique_lock lock(batchMutex_);
+            batchDoneCond_.wait(
+                lock, [&] { return br->finished == br->count; });
+            auto const it =
+                std::find(batchQueue_.begin(), batchQueue_.end(), br);
+            if (it != batchQueue_.end())
+                batchQueue_.erase(it);
+        }
+
+        if (br->error)
+            std::rethrow_exception(br->error);
+
+        return {std::move(br->results), ok};
     }
 
     void
@@ -235,7 +348,8 @@ public:
         e.prepare(no);
         nudb::error_code ec;
         nudb::detail::buffer bf;
-        auto const result = nodeobject_compress(e.getData(), e.getSize(), bf);
+        auto const result = nodeobject_compress(
+            e.getData(), e.getSize(), bf, dictionary_.get());
         db_.insert(e.getKey(), result.first, result.second, ec);
         if (ec && ec != nudb::error::key_exists)
             Throw<nudb::system_error>(ec);
@@ -289,15 +403,23 @@ public:
                 void const* data,
                 std::size_t size,
                 nudb::error_code&) {
-                nudb::detail::buffer bf;
-                auto const result = nodeobject_decompress(data, size, bf);
+                if (key_bytes == codecDictionaryKey().size() &&
+                    std::memcmp(
+                        key, codecDictionaryKey().data(), key_bytes) == 0)
+                    return;
+                SharedBufferFactory bf;
+                auto const result =
+                    nodeobject_decompress(data, size, bf, dictionary_.get());
                 DecodedBlob decoded(key, result.first, result.second);
                 if (!decoded.wasOk())
                 {
                     ec = make_error_code(nudb::error::missing_value);
                     return;
                 }
-                f(decoded.createObject());
+                if (auto buffer = bf.release())
+                    f(decoded.createObject(std::move(buffer)));
+                else
+                    f(decoded.createObject());
             },
             nudb::no_progress{},
             ec);
@@ -344,6 +466,140 @@ public:
     {
         return 3;
     }
+
+private:
+    // Load the dictionary embedded in the store. If there is none and
+    // one is configured, embed that one so that every object written
+    // with it stays readable.
+    void
+    openDictionary(bool embed)
+    {
+        auto const& key = codecDictionaryKey();
+        Blob data;
+        nudb::error_code ec;
+        db_.fetch(
+            key.data(),
+            [&data](void const* p, std::size_t size) {
+                auto const b = static_cast<std::uint8_t const*>(p);
+                data.assign(b, b + size);
+            },
+            ec);
+        if (ec && ec != nudb::error::key_not_found)
+            Throw<nudb::system_error>(ec);
+
+        if (!ec)
+        {
+            dictionary_ = std::make_shared<CodecDictionary>(std::move(data));
+            JLOG(j_.debug()) << name_ << ": compression dictionary "
+                             << dictionary_->id();
+            return;
+        }
+
+        if (!embed || dictionaryPath_.empty())
+            return;
+
+        std::ifstream file(dictionaryPath_, std::ios::binary);
+        if (!file)
+            Throw<std::runtime_error>(
+                "nodestore: unable to read compression_dictionary " +
+                dictionaryPath_);
+        data.assign(
+            std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>());
+        auto dict = std::make_shared<CodecDictionary>(std::move(data));
+        ec = {};
+        db_.insert(key.data(), dict->data().data(), dict->data().size(), ec);
+        if (ec)
+            Throw<nudb::system_error>(ec);
+        JLOG(j_.info()) << name_ << ": embedded compression dictionary "
+                        << dict->id();
+        dictionary_ = std::move(dict);
+    }
+
+    void
+    startBatchReaders()
+    {
+        std::lock_guard lock(batchMutex_);
+        batchStop_ = false;
+        batchReaders_.reserve(batchReadThreads_);
+        while (batchReaders_.size() < batchReadThreads_)
+            batchReaders_.emplace_back(&NuDBBackend::batchReader, this);
+    }
+
+    void
+    stopBatchReaders()
+    {
+        {
+            std::lock_guard lock(batchMutex_);
+            batchStop_ = true;
+        }
+        batchCond_.notify_all();
+        for (auto& t : batchReaders_)
+            t.join();
+        batchReaders_.clear();
+    }
+
+    // Claim and perform lookups from the batch until none remain
+    void
+    doBatchRead(BatchRead& br)
+    {
+        std::size_t done = 0;
+        std::exception_ptr error;
+        for (;;)
+        {
+            auto const i = br.next++;
+            if (i >= br.count)
+                break;
+            try
+            {
+                std::shared_ptr<NodeObject> nObj;
+                if (fetch(br.hashes[i]->begin(), &nObj) == ok)
+                    br.results[i] = std::move(nObj);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            ++done;
+        }
+
+        if (done == 0)
+            return;
+
+        std::lock_guard lock(batchMutex_);
+        if (error && !br.error)
+            br.error = error;
+        br.finished += done;
+        if (br.finished == br.count)
+            batchDoneCond_.notify_all();
+    }
+
+    void
+    batchReader()
+    {
+        beast::setCurrentThreadName("NuDB batch read");
+        std::unique_lock lock(batchMutex_);
+        for (;;)
+        {
+            batchCond_.wait(
+                lock, [this] { return batchStop_ || !batchQueue_.empty(); });
+            if (batchStop_)
+                return;
+
+            auto br = batchQueue_.front();
+            if (br->next >= br->count)
+            {
+                // Every lookup has been claimed; the remaining work
+                // belongs to whichever threads claimed it.
+                batchQueue_.pop_front();
+                continue;
+            }
+
+            lock.unlock();
+            doBatchRead(*br);
+            lock.lock();
+        }
+    }
 };
 
 //------------------------------------------------------------------------------
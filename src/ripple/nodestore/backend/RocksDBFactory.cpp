@@ -30,7 +30,11 @@
 #include <ripple/nodestore/impl/BatchWriter.h>
 #include <ripple/nodestore/impl/DecodedBlob.h>
 #include <ripple/nodestore/impl/EncodedBlob.h>
+#include <ripple/protocol/jss.h>
+#include <boost/algorithm/string/predicate.hpp>
 #include <atomic>
+#include <limits>
+#include <map>
 #include <memory>
 
 namespace ripple {
@@ -85,6 +89,10 @@ class RocksDBBackend : public Backend, public BatchWriter::Callback
 private:
     std::atomic<bool> m_deletePath;
 
+    // Sorted runs a write_once lookup may probe before compaction
+    // merges them
+    static constexpr int writeOnceSortedRuns = 8;
+
 public:
     beast::Journal m_journal;
     size_t const m_keyBytes;
@@ -108,6 +116,19 @@ public:
         if (!get_if_exists(keyValues, "path", m_name))
             Throw<std::runtime_error>("Missing path in RocksDBFactory backend");
 
+        // The write_once profile tunes the database for what the node
+        // store holds: immutable values under random keys, read only by
+        // point lookups and deleted a whole backend at a time by
+        // online_delete.
+        bool writeOnce = false;
+        if (std::string profile; get_if_exists(keyValues, "profile", profile))
+        {
+            writeOnce = boost::iequals(profile, "write_once");
+            if (!writeOnce && !boost::iequals(profile, "default"))
+                Throw<std::runtime_error>(
+                    "Unknown RocksDB profile: " + profile);
+        }
+
         rocksdb::BlockBasedTableOptions table_options;
         m_options.env = env;
 
@@ -169,6 +190,77 @@ public:
             m_options.write_buffer_size = 6 * m_options.target_file_size_base;
         }
 
+        if (writeOnce)
+        {
+            if (m_options.compaction_style != rocksdb::kCompactionStyleLevel)
+                Throw<std::runtime_error>(
+                    "RocksDB write_once profile excludes "
+                    "universal_compaction");
+
+            if (!keyValues.exists("online_delete"))
+            {
+                JLOG(m_journal.warn())
+                    << "RocksDB write_once profile never deletes data "
+                       "itself and should be used with online_delete";
+            }
+
+            // Keys are never overwritten or deleted, so merging files
+            // reclaims nothing, but every lookup probes each sorted run.
+            // Universal compaction merges runs of similar size, which keeps
+            // their number near the compaction trigger while each byte is
+            // rewritten only a logarithmic number of times. Writes stall
+            // rather than let the run count grow unbounded. Size
+            // amplification is not a concern: there is nothing to reclaim,
+            // and online_delete removes the whole backend instead.
+            m_options.compaction_style = rocksdb::kCompactionStyleUniversal;
+            m_options.level0_file_num_compaction_trigger =
+                writeOnceSortedRuns;
+            m_options.level0_slowdown_writes_trigger = 2 * writeOnceSortedRuns;
+            m_options.level0_stop_writes_trigger = 4 * writeOnceSortedRuns;
+            auto& universal = m_options.compaction_options_universal;
+            universal.size_ratio = 10;
+            universal.min_merge_width = 2;
+            universal.max_size_amplification_percent =
+                std::numeric_limits<unsigned int>::max();
+            universal.stop_style = rocksdb::kCompactionStopStyleTotalSize;
+            if (!keyValues.exists("file_size_mb"))
+                m_options.write_buffer_size = megabytes(128);
+
+            // Every lookup consults the filter of each file, so filters
+            // are whole-key, partitioned, and cached with the top level
+            // pinned. Without a prefix extractor the only iteration is the
+            // full scan used by import.
+            if (auto const bits = get<int>(keyValues, "filter_bits", 10))
+            {
+                table_options.filter_policy.reset(
+                    rocksdb::NewBloomFilterPolicy(bits, false));
+            }
+            table_options.whole_key_filtering = true;
+            table_options.partition_filters = true;
+            table_options.index_type =
+                rocksdb::BlockBasedTableOptions::kTwoLevelIndexSearch;
+            table_options.metadata_block_size = 4096;
+            table_options.cache_index_and_filter_blocks = true;
+            table_options.cache_index_and_filter_blocks_with_high_priority =
+                true;
+            table_options.pin_top_level_index_and_filter = true;
+            table_options.block_cache = rocksdb::NewLRUCache(
+                get<int>(keyValues, "cache_mb", 256) * megabytes(1),
+                -1,
+                false,
+                0.5);
+
+            // A hash index in each data block finds the key without a
+            // binary search.
+            table_options.data_block_index_type =
+                rocksdb::BlockBasedTableOptions::kDataBlockBinaryAndHash;
+            m_options.memtable_whole_key_filtering = true;
+            m_options.memtable_prefix_bloom_size_ratio = 0.02;
+
+            // Values are already compressed by the node object codec.
+            m_options.compression = rocksdb::kNoCompression;
+        }
+
         if (keyValues.exists("bbt_options"))
         {
             auto const s = rocksdb::GetBlockBasedTableOptionsFromString(
@@ -269,11 +361,14 @@ public:
 
         if (getStatus.ok())
         {
-            DecodedBlob decoded(key, string.data(), string.size());
+            // The object references the value in place, so the string
+            // is handed over to it rather than copied.
+            auto value = std::make_shared<std::string const>(std::move(string));
+            DecodedBlob decoded(key, value->data(), value->size());
 
             if (decoded.wasOk())
             {
-                *pObject = decoded.createObject();
+                *pObject = decoded.createObject(std::move(value));
             }
             else
             {
@@ -417,6 +512,27 @@ public:
         storeBatch(batch);
     }
 
+    void
+    getCountsJson(Json::Value& obj) override
+    {
+        std::map<std::string, std::string> stats;
+        if (!m_db ||
+            !m_db->GetMapProperty(rocksdb::DB::Properties::kCFStats, &stats))
+            return;
+
+        if (auto const it = stats.find("compaction.Sum.WriteAmp");
+            it != stats.end())
+            obj[jss::rocksdb_write_amplification] = it->second;
+
+        std::uint64_t value = 0;
+        if (m_db->GetIntProperty(
+                rocksdb::DB::Properties::kCompactionPending, &value))
+            obj[jss::rocksdb_compaction_pending] = std::to_string(value);
+        if (m_db->GetIntProperty(
+                rocksdb::DB::Properties::kNumRunningCompactions, &value))
+            obj[jss::rocksdb_running_compactions] = std::to_string(value);
+    }
+
     /** Returns the number of file descriptors the backend expects to need */
     int
     fdRequired() const override
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_BLOOMFILTER_H_INCLUDED
+#define RIPPLE_NODESTORE_BLOOMFILTER_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A Bloom filter over node object keys.
+
+    Keys are already uniformly distributed hashes, so the bit positions
+    are derived from the key itself instead of hashing it again.
+
+    @note insert and mayContain can be called concurrently.
+*/
+class BloomFilter
+{
+public:
+    /** Number of bits set for each key.
+
+        This is the best choice at about 10 bits per key, where roughly
+        one lookup in a hundred for an absent key is a false positive.
+    */
+    static constexpr int hashes = 7;
+
+    /** Create an empty filter using about `bytes` of memory. */
+    explicit BloomFilter(std::size_t bytes)
+        : words_(std::max<std::size_t>(bytes / sizeof(std::uint64_t), 1))
+        , bits_(words_ * 64)
+        , data_(new std::atomic<std::uint64_t>[words_])
+    {
+        for (std::size_t i = 0; i < words_; ++i)
+            data_[i].store(0, std::memory_order_relaxed);
+    }
+
+    BloomFilter(BloomFilter const&) = delete;
+    BloomFilter&
+    operator=(BloomFilter const&) = delete;
+
+    void
+    insert(uint256 const& key)
+    {
+        auto [h1, h2] = split(key);
+        for (int i = 0; i < hashes; ++i, h1 += h2)
+        {
+            auto const bit = h1 % bits_;
+            data_[bit / 64].fetch_or(
+                std::uint64_t(1) << (bit % 64), std::memory_order_relaxed);
+        }
+    }
+
+    /** Returns `false` if the key was definitely never inserted. */
+    bool
+    mayContain(uint256 const& key) const
+    {
+        auto [h1, h2] = split(key);
+        for (int i = 0; i < hashes; ++i, h1 += h2)
+        {
+            auto const bit = h1 % bits_;
+            if (!(data_[bit / 64].load(std::memory_order_relaxed) &
+                  (std::uint64_t(1) << (bit % 64))))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    // Two independent 64-bit hashes, for double hashing
+    static std::pair<std::uint64_t, std::uint64_t>
+    split(uint256 const& key)
+    {
+        std::uint64_t h[2];
+        std::memcpy(h, key.data(), sizeof(h));
+        // An odd step visits distinct bits when the size is a power of 2
+        return {h[0], h[1] | 1};
+    }
+
+    std::size_t const words_;
+    std::uint64_t const bits_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> const data_;
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,226 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/contract.h>
+#include <ripple/basics/random.h>
+#include <ripple/nodestore/CodecDictionary.h>
+#include <ripple/nodestore/impl/EncodedBlob.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <zdict.h>
+#include <zstd.h>
+
+namespace ripple {
+namespace NodeStore {
+
+namespace {
+
+struct CCtxDeleter
+{
+    void
+    operator()(ZSTD_CCtx* ctx) const
+    {
+        ZSTD_freeCCtx(ctx);
+    }
+};
+
+struct DCtxDeleter
+{
+    void
+    operator()(ZSTD_DCtx* ctx) const
+    {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+// Contexts hold the working memory of the codec; keeping one per
+// thread avoids allocating it for every object.
+ZSTD_CCtx*
+compressContext()
+{
+    thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> const ctx(
+        ZSTD_createCCtx());
+    if (!ctx)
+        Throw<std::runtime_error>("zstd: ZSTD_createCCtx");
+    return ctx.get();
+}
+
+ZSTD_DCtx*
+decompressContext()
+{
+    thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> const ctx(
+        ZSTD_createDCtx());
+    if (!ctx)
+        Throw<std::runtime_error>("zstd: ZSTD_createDCtx");
+    return ctx.get();
+}
+
+void
+check(std::size_t result, char const* what)
+{
+    if (ZSTD_isError(result))
+        Throw<std::runtime_error>(
+            std::string("zstd: ") + what + ": " + ZSTD_getErrorName(result));
+}
+
+// Inner nodes are encoded as bare hashes and never use the dictionary
+bool
+isInnerNode(EncodedBlob const& e)
+{
+    if (e.getSize() != 525)
+        return false;
+    auto const p = static_cast<std::uint8_t const*>(e.getData()) + 9;
+    auto const prefix = (std::uint32_t(p[0]) << 24) |
+        (std::uint32_t(p[1]) << 16) | (std::uint32_t(p[2]) << 8) | p[3];
+    return prefix == static_cast<std::uint32_t>(HashPrefix::innerNode);
+}
+
+}  // namespace
+
+CodecDictionary::CodecDictionary(Blob data)
+    : data_(std::move(data))
+    , id_(ZSTD_getDictID_fromDict(data_.data(), data_.size()))
+{
+    if (id_ == 0)
+        Throw<std::runtime_error>("zstd: not a dictionary");
+
+    cdict_ = ZSTD_createCDict(data_.data(), data_.size(), ZSTD_CLEVEL_DEFAULT);
+    ddict_ = ZSTD_createDDict(data_.data(), data_.size());
+    if (!cdict_ || !ddict_)
+    {
+        ZSTD_freeCDict(cdict_);
+        ZSTD_freeDDict(ddict_);
+        Throw<std::runtime_error>("zstd: bad dictionary");
+    }
+}
+
+CodecDictionary::~CodecDictionary()
+{
+    ZSTD_freeCDict(cdict_);
+    ZSTD_freeDDict(ddict_);
+}
+
+std::size_t
+CodecDictionary::compressBound(std::size_t size)
+{
+    return ZSTD_compressBound(size);
+}
+
+std::size_t
+CodecDictionary::compress(
+    void const* in,
+    std::size_t inSize,
+    void* out,
+    std::size_t outMax) const
+{
+    auto const ctx = compressContext();
+    // The codec records the size and the dictionary itself, so
+    // leave both out of the frame.
+    check(
+        ZSTD_CCtx_reset(ctx, ZSTD_reset_session_and_parameters), "reset");
+    check(ZSTD_CCtx_setParameter(ctx, ZSTD_c_contentSizeFlag, 0), "param");
+    check(ZSTD_CCtx_setParameter(ctx, ZSTD_c_dictIDFlag, 0), "param");
+    check(ZSTD_CCtx_refCDict(ctx, cdict_), "refCDict");
+    auto const n = ZSTD_compress2(ctx, out, outMax, in, inSize);
+    check(n, "compress");
+    return n;
+}
+
+std::size_t
+CodecDictionary::decompress(
+    void const* in,
+    std::size_t inSize,
+    void* out,
+    std::size_t outSize) const
+{
+    auto const n = ZSTD_decompress_usingDDict(
+        decompressContext(), out, outSize, in, inSize, ddict_);
+    check(n, "decompress");
+    return n;
+}
+
+Blob
+CodecDictionary::train(std::vector<Blob> const& samples, std::size_t capacity)
+{
+    Blob buffer;
+    std::vector<std::size_t> sizes;
+    sizes.reserve(samples.size());
+    for (auto const& s : samples)
+    {
+        buffer.insert(buffer.end(), s.begin(), s.end());
+        sizes.push_back(s.size());
+    }
+
+    Blob dict(capacity);
+    auto const n = ZDICT_trainFromBuffer(
+        dict.data(),
+        dict.size(),
+        buffer.data(),
+        sizes.data(),
+        static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(n))
+        Throw<std::runtime_error>(
+            std::string("zstd: train: ") + ZDICT_getErrorName(n));
+    dict.resize(n);
+    return dict;
+}
+
+uint256 const&
+codecDictionaryKey()
+{
+    static uint256 const key = [] {
+        uint256 k;
+        std::memcpy(k.data(), "ZSTDDICT", 8);
+        return k;
+    }();
+    return key;
+}
+
+Blob
+trainCodecDictionary(
+    Backend& backend,
+    std::size_t maxSamples,
+    std::size_t capacity)
+{
+    // Reservoir sample, so every object is equally likely to be
+    // chosen without knowing the size of the store in advance.
+    std::vector<Blob> samples;
+    samples.reserve(maxSamples);
+    std::uint64_t seen = 0;
+    backend.for_each([&](std::shared_ptr<NodeObject> object) {
+        EncodedBlob e;
+        e.prepare(object);
+        if (isInnerNode(e))
+            return;
+        auto const p = static_cast<std::uint8_t const*>(e.getData());
+        if (samples.size() < maxSamples)
+            samples.emplace_back(p, p + e.getSize());
+        else if (auto const i = rand_int<std::uint64_t>(seen);
+                 i < maxSamples)
+            samples[i].assign(p, p + e.getSize());
+        ++seen;
+    });
+    return CodecDictionary::train(samples, capacity);
+}
+
+}  // namespace NodeStore
+}  // namespace ripple
@@ -24,6 +24,7 @@
 #include <ripple/nodestore/Database.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/jss.h>
+#include <algorithm>
 #include <chrono>
 
 namespace ripple {
@@ -33,7 +34,8 @@ Database::Database(
     Scheduler& scheduler,
     int readThreads,
     Section const& config,
-    beast::Journal journal)
+    beast::Journal journal,
+    std::optional<std::chrono::milliseconds> readThreadIdleTimeout)
     : j_(journal)
     , scheduler_(scheduler)
     , ledgersPerShard_(get<std::uint32_t>(
@@ -43,6 +45,12 @@ Database::Database(
     , earliestLedgerSeq_(
           get<std::uint32_t>(config, "earliest_seq", XRP_LEDGER_EARLIEST_SEQ))
     , earliestShardIndex_((earliestLedgerSeq_ - 1) / ledgersPerShard_)
+    , readThreadsMin_(std::max(readThreads, 0))
+    , readThreadsMax_(std::max(
+          readThreadsMin_,
+          get<int>(config, "read_threads_max", std::max(readThreads, 16))))
+    , readThreadIdleTimeout_(
+          readThreadIdleTimeout.value_or(defaultReadThreadIdleTimeout))
 {
     if (ledgersPerShard_ == 0 || ledgersPerShard_ % 256 != 0)
         Throw<std::runtime_error>("Invalid ledgers_per_shard");
@@ -50,8 +58,9 @@ Database::Database(
     if (earliestLedgerSeq_ < 1)
         Throw<std::runtime_error>("Invalid earliest_seq");
 
-    while (readThreads-- > 0)
-        readThreads_.emplace_back(&Database::threadEntry, this);
+    std::lock_guard lock(readLock_);
+    while (readThreadCount_ < readThreadsMin_)
+        startReadThread(lock);
 }
 
 Database::~Database()
@@ -111,10 +120,97 @@ Database::asyncFetch(
 {
     // Post a read
     std::lock_guard lock(readLock_);
-    read_[hash].emplace_back(ledgerSeq, std::move(cb));
+    auto [it, inserted] = read_.try_emplace(hash);
+    if (inserted)
+        it->second.queued = std::chrono::steady_clock::now();
+    it->second.callbacks.emplace_back(ledgerSeq, std::move(cb));
+    readQueueMax_ = std::max(readQueueMax_, read_.size());
+
+    // Grow the pool if every thread is busy and, at the observed
+    // latency, the queue would take too long to drain
+    if (!readStopping_ && readThreadsIdle_ == 0 &&
+        readThreadCount_ < readThreadsMax_)
+    {
+        using namespace std::chrono;
+        auto const batches{
+            (read_.size() + asyncReadBatchLimit - 1) / asyncReadBatchLimit};
+        auto const drainUs{
+            batches * readBatchDurationUs_.load() /
+            std::max(readThreadCount_, 1)};
+        if (readThreadCount_ == 0 ||
+            drainUs > static_cast<std::uint64_t>(
+                          microseconds(readQueueTarget).count()))
+        {
+            startReadThread(lock);
+        }
+    }
+
     readCondVar_.notify_one();
 }
 
+void
+Database::startReadThread(std::lock_guard<std::mutex> const&)
+{
+    for (auto const& id : readThreadsFinished_)
+    {
+        auto const it = std::find_if(
+            readThreads_.begin(), readThreads_.end(), [&id](auto const& t) {
+                return t.get_id() == id;
+            });
+        if (it != readThreads_.end())
+        {
+            // The thread has released the lock and is returning
+            it->join();
+            readThreads_.erase(it);
+        }
+    }
+    readThreadsFinished_.clear();
+
+    ++readThreadCount_;
+    readThreads_.emplace_back(&Database::threadEntry, this);
+}
+
+void
+Database::collectMetrics(beast::insight::Collector::ptr const& collector)
+{
+    auto stats{std::make_shared<Stats>([this] { collect(); }, collector)};
+
+    // The old hook is released outside the lock, since the collector
+    // holds its own lock while it calls collect()
+    {
+        std::lock_guard lock(readLock_);
+        std::swap(stats_, stats);
+    }
+}
+
+void
+Database::collect()
+{
+    std::lock_guard lock(readLock_);
+    if (stats_)
+    {
+        stats_->readThreads.set(readThreadCount_);
+        stats_->readQueue.set(read_.size());
+        stats_->fetchSync.set(fetchSyncLatency_);
+        stats_->fetchAsync.set(fetchAsyncLatency_);
+        stats_->readBatch.set(readBatchLatency_);
+        stats_->store.set(storeLatency_);
+        stats_->storeBatch.set(storeBatchLatency_);
+    }
+}
+
+void
+Database::Stats::Latency::set(LatencyHistogram const& histogram)
+{
+    auto const counts{histogram.snapshot()};
+    auto const recent{LatencyHistogram::since(counts, last)};
+    last = counts;
+
+    p50.set(LatencyHistogram::percentile(recent, 50).count());
+    p99.set(LatencyHistogram::percentile(recent, 99).count());
+    max.set(LatencyHistogram::percentile(recent, 100).count());
+}
+
 void
 Database::importInternal(Backend& dstBackend, Database& srcDB)
 {
@@ -123,7 +219,9 @@ Database::importInternal(Backend& dstBackend, Database& srcDB)
     auto storeBatch = [&, fname = __func__]() {
         try
         {
+            auto const begin{std::chrono::steady_clock::now()};
             dstBackend.storeBatch(batch);
+            updateStoreBatchLatency(std::chrono::steady_clock::now() - begin);
         }
         catch (std::exception const& e)
         {
@@ -173,8 +271,12 @@ Database::fetchNodeObject(
     }
     ++fetchTotalCount_;
 
-    fetchReport.elapsed =
-        duration_cast<milliseconds>(steady_clock::now() - begin);
+    auto const elapsed{steady_clock::now() - begin};
+    (fetchType == FetchType::synchronous ? fetchSyncLatency_
+                                         : fetchAsyncLatency_)
+        .record(duration_cast<microseconds>(elapsed));
+
+    fetchReport.elapsed = duration_cast<milliseconds>(elapsed);
     scheduler_.onFetch(fetchReport);
     return nodeObject;
 }
@@ -208,7 +310,9 @@ Database::storeLedger(
 
         try
         {
+            auto const begin{std::chrono::steady_clock::now()};
             dstBackend->storeBatch(batch);
+            updateStoreBatchLatency(std::chrono::steady_clock::now() - begin);
         }
         catch (std::exception const& e)
         {
@@ -278,26 +382,60 @@ Database::storeLedger(
     return true;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchNodeObjects(
+    std::vector<uint256 const*> const& hashes,
+    std::uint32_t ledgerSeq)
+{
+    std::vector<std::shared_ptr<NodeObject>> results;
+    results.reserve(hashes.size());
+    for (auto const hash : hashes)
+    {
+        FetchReport fetchReport(FetchType::async);
+        results.push_back(fetchNodeObject(*hash, ledgerSeq, fetchReport));
+    }
+    return results;
+}
+
 // Entry point for async read threads
 void
 Database::threadEntry()
 {
     beast::setCurrentThreadName("prefetch");
+    using namespace std::chrono;
+
     while (true)
     {
-        uint256 lastHash;
-        std::vector<std::pair<
-            std::uint32_t,
-            std::function<void(std::shared_ptr<NodeObject> const&)>>>
-            entry;
+        // Pending reads, coalesced by hash and in key order
+        std::vector<std::pair<uint256, ReadCallbacks>> entries;
+
+        // Mean time the reads waited in the queue
+        steady_clock::duration queueWait{0};
+        std::shared_ptr<Stats> stats;
 
         {
             std::unique_lock<std::mutex> lock(readLock_);
-            readCondVar_.wait(
-                lock, [this] { return readStopping_ || !read_.empty(); });
+            ++readThreadsIdle_;
+            bool const ready = readCondVar_.wait_for(
+                lock, readThreadIdleTimeout_, [this] {
+                    return readStopping_ || !read_.empty();
+                });
+            --readThreadsIdle_;
             if (readStopping_)
                 break;
 
+            if (!ready)
+            {
+                // Shrink the pool back toward its minimum
+                if (readThreadCount_ > readThreadsMin_)
+                {
+                    --readThreadCount_;
+                    readThreadsFinished_.push_back(std::this_thread::get_id());
+                    break;
+                }
+                continue;
+            }
+
             // Read in key order to make the back end more efficient
             auto it = read_.lower_bound(readLastHash_);
             if (it == read_.end())
@@ -305,22 +443,100 @@ Database::threadEntry()
                 // start over from the beginning
                 it = read_.begin();
             }
-            lastHash = it->first;
-            entry = std::move(it->second);
-            read_.erase(it);
-            readLastHash_ = lastHash;
+
+            entries.reserve(std::min<std::size_t>(
+                read_.size(), asyncReadBatchLimit));
+            auto const now{steady_clock::now()};
+            do
+            {
+                queueWait += now - it->second.queued;
+                entries.emplace_back(
+                    it->first, std::move(it->second.callbacks));
+                it = read_.erase(it);
+            } while (it != read_.end() && entries.size() < asyncReadBatchLimit);
+            readLastHash_ = entries.back().first;
+            queueWait /= entries.size();
+            stats = stats_;
         }
 
-        auto seq = entry[0].first;
-        auto obj = fetchNodeObject(lastHash, seq, FetchType::async);
+        if (stats)
+            stats->readQueueWait.notify(duration_cast<milliseconds>(queueWait));
 
-        for (auto const& req : entry)
+        // Group the reads by the database they will be satisfied from
+        std::vector<std::pair<std::uint32_t, std::vector<std::size_t>>> groups;
+        for (std::size_t i = 0; i < entries.size(); ++i)
         {
-            if ((seq == req.first) || isSameDB(req.first, seq))
-                req.second(obj);
+            auto const seq = entries[i].second.front().first;
+            auto const it = std::find_if(
+                groups.begin(), groups.end(), [&](auto const& group) {
+                    return group.first == seq || isSameDB(group.first, seq);
+                });
+            if (it == groups.end())
+                groups.emplace_back(seq, std::vector<std::size_t>{i});
             else
-                req.second(
-                    fetchNodeObject(lastHash, req.first, FetchType::async));
+                it->second.push_back(i);
+        }
+
+        for (auto const& [seq, indexes] : groups)
+        {
+            std::vector<uint256 const*> hashes;
+            hashes.reserve(indexes.size());
+            for (auto const i : indexes)
+                hashes.push_back(&entries[i].first);
+
+            auto const begin{steady_clock::now()};
+
+            auto const objs{fetchNodeObjects(hashes, seq)};
+            assert(objs.size() == hashes.size());
+
+            auto const elapsed{steady_clock::now() - begin};
+            readBatchLatency_.record(duration_cast<microseconds>(elapsed));
+
+            // Weigh recent batches more, so the pool follows the backend
+            {
+                std::uint64_t const us =
+                    duration_cast<microseconds>(elapsed).count();
+                auto const avg{readBatchDurationUs_.load()};
+                readBatchDurationUs_.store(avg ? (avg * 7 + us) / 8 : us);
+            }
+
+            std::uint64_t hits{0};
+            for (auto const& obj : objs)
+            {
+                if (obj)
+                {
+                    ++hits;
+                    fetchSz_ += obj->getData().size();
+                }
+            }
+            updateFetchMetrics(
+                hashes.size(),
+                hits,
+                duration_cast<microseconds>(elapsed).count());
+            ++readBatchCount_;
+            readBatchObjects_ += hashes.size();
+
+            // Report the batch as one fetch with its full latency. An
+            // object's share of it would truncate to zero milliseconds.
+            {
+                FetchReport fetchReport(FetchType::async);
+                fetchReport.elapsed = duration_cast<milliseconds>(elapsed);
+                fetchReport.wasFound = hits != 0;
+                scheduler_.onFetch(fetchReport);
+            }
+
+            for (std::size_t j = 0; j < indexes.size(); ++j)
+            {
+                auto const& [hash, entry] = entries[indexes[j]];
+                for (auto const& req : entry)
+                {
+                    if ((seq == req.first) || isSameDB(req.first, seq))
+                        req.second(objs[j]);
+                    else
+                        req.second(
+                            fetchNodeObject(hash, req.first, FetchType::async));
+                }
+            }
         }
     }
 }
@@ -335,6 +551,36 @@ Database::getCountsJson(Json::Value& obj)
     obj[jss::node_written_bytes] = std::to_string(storeSz_);
     obj[jss::node_read_bytes] = std::to_string(fetchSz_);
     obj[jss::node_reads_duration_us] = std::to_string(fetchDurationUs_);
+    obj[jss::node_read_batches] = std::to_string(readBatchCount_);
+    obj[jss::node_read_batch_objects] = std::to_string(readBatchObjects_);
+
+    auto latencyJson = [](LatencyHistogram const& histogram) {
+        auto const counts{histogram.snapshot()};
+        auto percentile = [&](double percent) {
+            return std::to_string(
+                LatencyHistogram::percentile(counts, percent).count());
+        };
+
+        Json::Value jv(Json::objectValue);
+        jv[jss::count] = std::to_string(LatencyHistogram::total(counts));
+        jv[jss::p50] = percentile(50);
+        jv[jss::p90] = percentile(90);
+        jv[jss::p99] = percentile(99);
+        jv[jss::p999] = percentile(99.9);
+        jv[jss::max] = percentile(100);
+        return jv;
+    };
+    obj[jss::node_reads_sync_latency_us] = latencyJson(fetchSyncLatency_);
+    obj[jss::node_reads_async_latency_us] = latencyJson(fetchAsyncLatency_);
+    obj[jss::node_read_batches_latency_us] = latencyJson(readBatchLatency_);
+    obj[jss::node_writes_latency_us] = latencyJson(storeLatency_);
+    obj[jss::node_write_batches_latency_us] = latencyJson(storeBatchLatency_);
+    {
+        std::lock_guard lock(readLock_);
+        obj[jss::node_read_queue] = std::to_string(read_.size());
+        obj[jss::node_read_queue_max] = std::to_string(readQueueMax_);
+        obj[jss::node_read_threads] = std::to_string(readThreadCount_);
+    }
 
     if (auto c = getCounters())
     {
@@ -32,7 +32,10 @@ DatabaseNodeImp::store(
     std::uint32_t)
 {
     auto nObj = NodeObject::createObject(type, std::move(data), hash);
+
+    auto const begin{std::chrono::steady_clock::now()};
     backend_->store(nObj);
+    updateStoreLatency(std::chrono::steady_clock::now() - begin);
     storeStats(1, nObj->getData().size());
 }
 
@@ -43,6 +46,15 @@ DatabaseNodeImp::sweep()
         cache_->sweep();
 }
 
+void
+DatabaseNodeImp::getCountsJson(Json::Value& obj)
+{
+    Database::getCountsJson(obj);
+    backend_->getCountsJson(obj);
+    if (tieredCache_)
+        tieredCache_->getCountsJson(obj);
+}
+
 std::shared_ptr<NodeObject>
 DatabaseNodeImp::fetchNodeObject(
     uint256 const& hash,
@@ -55,11 +67,21 @@ DatabaseNodeImp::fetchNodeObject(
     {
         JLOG(j_.trace())
             << "DatabaseNodeImp::fetchNodeObject - record not in cache";
-        Status status;
+        Status status{notFound};
 
         try
         {
-            status = backend_->fetch(hash.data(), &nodeObject);
+            if (tieredCache_)
+                nodeObject = tieredCache_->fetch(hash);
+
+            if (nodeObject)
+                status = ok;
+            else
+            {
+                status = backend_->fetch(hash.data(), &nodeObject);
+                if (status == ok && nodeObject && tieredCache_)
+                    tieredCache_->insert(nodeObject);
+            }
         }
         catch (std::exception const& e)
         {
@@ -100,6 +122,53 @@ DatabaseNodeImp::fetchNodeObject(
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseNodeImp::fetchNodeObjects(
+    std::vector<uint256 const*> const& hashes,
+    std::uint32_t)
+{
+    std::vector<std::shared_ptr<NodeObject>> results{hashes.size()};
+    std::vector<uint256 const*> cacheMisses;
+    std::vector<std::size_t> missIndexes;
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+        if (auto nObj = cache_ ? cache_->fetch(*hashes[i]) : nullptr)
+            results[i] = std::move(nObj);
+        else
+        {
+            cacheMisses.push_back(hashes[i]);
+            missIndexes.push_back(i);
+        }
+    }
+
+    if (cacheMisses.empty())
+        return results;
+
+    std::vector<std::shared_ptr<NodeObject>> dbResults;
+    try
+    {
+        dbResults = fetchFromBackend(cacheMisses);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.fatal()) << "Exception, " << e.what();
+        Rethrow();
+    }
+
+    for (std::size_t i = 0; i < dbResults.size(); ++i)
+    {
+        auto& nObj = dbResults[i];
+        if (nObj && cache_)
+        {
+            // Ensure all threads get the same object
+            cache_->canonicalize_replace_client(*cacheMisses[i], nObj);
+        }
+        results[missIndexes[i]] = std::move(nObj);
+    }
+
+    return results;
+}
+
 std::vector<std::shared_ptr<NodeObject>>
 DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
 {
@@ -133,7 +202,7 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
     JLOG(j_.debug()) << "DatabaseNodeImp::fetchBatch - cache hits = "
                      << (hashes.size() - cacheMisses.size())
                      << " - cache misses = " << cacheMisses.size();
-    auto dbResults = backend_->fetchBatch(cacheMisses).first;
+    auto dbResults = fetchFromBackend(cacheMisses);
 
     for (size_t i = 0; i < dbResults.size(); ++i)
     {
@@ -164,5 +233,39 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
     return results;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseNodeImp::fetchFromBackend(std::vector<uint256 const*> const& hashes)
+{
+    if (!tieredCache_)
+        return backend_->fetchBatch(hashes).first;
+
+    std::vector<std::shared_ptr<NodeObject>> results{hashes.size()};
+    std::vector<uint256 const*> misses;
+    std::vector<std::size_t> missIndexes;
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+        if (auto nObj = tieredCache_->fetch(*hashes[i]))
+            results[i] = std::move(nObj);
+        else
+        {
+            misses.push_back(hashes[i]);
+            missIndexes.push_back(i);
+        }
+    }
+
+    if (misses.empty())
+        return results;
+
+    auto dbResults = backend_->fetchBatch(misses).first;
+    for (std::size_t i = 0; i < dbResults.size(); ++i)
+    {
+        if (dbResults[i])
+            tieredCache_->insert(dbResults[i]);
+        results[missIndexes[i]] = std::move(dbResults[i]);
+    }
+
+    return results;
+}
+
 }  // namespace NodeStore
 }  // namespace ripple
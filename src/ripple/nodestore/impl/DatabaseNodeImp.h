@@ -23,6 +23,7 @@
 #include <ripple/basics/TaggedCache.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/nodestore/Database.h>
+#include <ripple/nodestore/impl/TieredCache.h>
 
 namespace ripple {
 namespace NodeStore {
@@ -39,10 +40,12 @@ public:
         Scheduler& scheduler,
         int readThreads,
         std::shared_ptr<Backend> backend,
+        std::unique_ptr<TieredCache> tieredCache,
         Section const& config,
         beast::Journal j)
         : Database(scheduler, readThreads, config, j)
         , backend_(std::move(backend))
+        , tieredCache_(std::move(tieredCache))
     {
         std::optional<int> cacheSize, cacheAge;
         if (config.exists("cache_size"))
@@ -77,6 +80,8 @@ public:
                 j);
         }
         assert(backend_);
+        if (tieredCache_)
+            fdRequired_ += tieredCache_->fdRequired();
     }
 
     ~DatabaseNodeImp()
@@ -129,12 +134,22 @@ public:
     void
     sweep() override;
 
+    void
+    getCountsJson(Json::Value& obj) override;
+
 private:
     // Cache for database objects. This cache is not always initialized. Check
     // for null before using.
     std::shared_ptr<TaggedCache<uint256, NodeObject>> cache_;
     // Persistent key/value storage
     std::shared_ptr<Backend> backend_;
+    // Optional cache on fast storage between cache_ and backend_
+    std::unique_ptr<TieredCache> tieredCache_;
+
+    // Fetch from the tiered cache, if any, and then from the backend.
+    // Objects found in the backend are added to the tiered cache.
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchFromBackend(std::vector<uint256 const*> const& hashes);
 
     std::shared_ptr<NodeObject>
     fetchNodeObject(
@@ -142,6 +157,11 @@ private:
         std::uint32_t,
         FetchReport& fetchReport) override;
 
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256 const*> const& hashes,
+        std::uint32_t) override;
+
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override
     {
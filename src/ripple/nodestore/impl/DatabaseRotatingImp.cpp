@@ -18,12 +18,158 @@
 //==============================================================================
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/nodestore/impl/BloomFilter.h>
 #include <ripple/nodestore/impl/DatabaseRotatingImp.h>
 #include <ripple/protocol/HashPrefix.h>
 
 namespace ripple {
 namespace NodeStore {
 
+namespace {
+
+// A backend that remembers every key written to it in a Bloom filter,
+// so lookups of keys it definitely lacks never reach the disk. The
+// filter only knows about keys written through this wrapper, so only
+// a backend that starts out empty may be wrapped.
+class FilteredBackend : public Backend
+{
+    std::shared_ptr<Backend> const backend_;
+    BloomFilter filter_;
+
+public:
+    FilteredBackend(std::shared_ptr<Backend> backend, std::size_t bytes)
+        : backend_(std::move(backend)), filter_(bytes)
+    {
+    }
+
+    std::string
+    getName() override
+    {
+        return backend_->getName();
+    }
+
+    void
+    open(bool createIfMissing) override
+    {
+        backend_->open(createIfMissing);
+    }
+
+    bool
+    isOpen() override
+    {
+        return backend_->isOpen();
+    }
+
+    void
+    close() override
+    {
+        backend_->close();
+    }
+
+    Status
+    fetch(void const* key, std::shared_ptr<NodeObject>* pObject) override
+    {
+        if (!filter_.mayContain(uint256::fromVoid(key)))
+        {
+            pObject->reset();
+            return notFound;
+        }
+        return backend_->fetch(key, pObject);
+    }
+
+    std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
+    fetchBatch(std::vector<uint256 const*> const& hashes) override
+    {
+        std::vector<uint256 const*> probes;
+        std::vector<std::size_t> indexes;
+        for (std::size_t i = 0; i < hashes.size(); ++i)
+        {
+            if (filter_.mayContain(*hashes[i]))
+            {
+                probes.push_back(hashes[i]);
+                indexes.push_back(i);
+            }
+        }
+
+        std::vector<std::shared_ptr<NodeObject>> results(hashes.size());
+        if (probes.empty())
+            return {std::move(results), ok};
+
+        auto [found, status] = backend_->fetchBatch(probes);
+        for (std::size_t i = 0; i < found.size(); ++i)
+            results[indexes[i]] = std::move(found[i]);
+        return {std::move(results), status};
+    }
+
+    // Keys enter the filter before the object is written, so a
+    // concurrent fetch can never skip an object that is present.
+    void
+    store(std::shared_ptr<NodeObject> const& object) override
+    {
+        filter_.insert(object->getHash());
+        backend_->store(object);
+    }
+
+    void
+    storeBatch(Batch const& batch) override
+    {
+        for (auto const& object : batch)
+            filter_.insert(object->getHash());
+        backend_->storeBatch(batch);
+    }
+
+    void
+    sync() override
+    {
+        backend_->sync();
+    }
+
+    void
+    for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override
+    {
+        backend_->for_each(std::move(f));
+    }
+
+    int
+    getWriteLoad() override
+    {
+        return backend_->getWriteLoad();
+    }
+
+    void
+    setDeletePath() override
+    {
+        backend_->setDeletePath();
+    }
+
+    void
+    verify() override
+    {
+        backend_->verify();
+    }
+
+    int
+    fdRequired() const override
+    {
+        return backend_->fdRequired();
+    }
+
+    std::optional<Counters<std::uint64_t>>
+    counters() const override
+    {
+        return backend_->counters();
+    }
+
+    void
+    getCountsJson(Json::Value& obj) override
+    {
+        backend_->getCountsJson(obj);
+    }
+};
+
+}  // namespace
+
 DatabaseRotatingImp::DatabaseRotatingImp(
     Scheduler& scheduler,
     int readThreads,
@@ -34,6 +180,7 @@ DatabaseRotatingImp::DatabaseRotatingImp(
     : DatabaseRotating(scheduler, readThreads, config, j)
     , writableBackend_(std::move(writableBackend))
     , archiveBackend_(std::move(archiveBackend))
+    , filterBytes_(megabytes(get<std::size_t>(config, "rotating_filter_mb", 0)))
 {
     if (writableBackend_)
         fdRequired_ += writableBackend_->fdRequired();
@@ -48,12 +195,41 @@ DatabaseRotatingImp::rotateWithLock(
 {
     std::lock_guard lock(mutex_);
 
-    auto newBackend = f(writableBackend_->getName());
+    std::shared_ptr<Backend> newBackend = f(writableBackend_->getName());
+    // The new backend is empty, so a filter can track all of its keys
+    if (filterBytes_)
+        newBackend = std::make_shared<FilteredBackend>(
+            std::move(newBackend), filterBytes_);
     archiveBackend_->setDeletePath();
     archiveBackend_ = std::move(writableBackend_);
     writableBackend_ = std::move(newBackend);
 }
 
+std::size_t
+DatabaseRotatingImp::copyToWritable(std::vector<uint256 const*> const& hashes)
+{
+    using namespace std::chrono;
+    auto const begin{steady_clock::now()};
+
+    // Fetching moves anything found in the archive to the writable backend
+    auto const objs{fetchNodeObjects(hashes, 0)};
+
+    std::size_t hits{0};
+    for (auto const& obj : objs)
+    {
+        if (obj)
+        {
+            ++hits;
+            fetchSz_ += obj->getData().size();
+        }
+    }
+    updateFetchMetrics(
+        hashes.size(),
+        hits,
+        duration_cast<microseconds>(steady_clock::now() - begin).count());
+    return hits;
+}
+
 std::string
 DatabaseRotatingImp::getName() const
 {
@@ -111,7 +287,9 @@ DatabaseRotatingImp::store(
         return writableBackend_;
     }();
 
+    auto const begin{std::chrono::steady_clock::now()};
     backend->store(nObj);
+    updateStoreLatency(std::chrono::steady_clock::now() - begin);
     storeStats(1, nObj->getData().size());
 }
 
@@ -121,6 +299,18 @@ DatabaseRotatingImp::sweep()
     // nothing to do
 }
 
+void
+DatabaseRotatingImp::getCountsJson(Json::Value& obj)
+{
+    Database::getCountsJson(obj);
+
+    auto const backend = [&] {
+        std::lock_guard lock(mutex_);
+        return writableBackend_;
+    }();
+    backend->getCountsJson(obj);
+}
+
 std::shared_ptr<NodeObject>
 DatabaseRotatingImp::fetchNodeObject(
     uint256 const& hash,
@@ -193,6 +383,76 @@ DatabaseRotatingImp::fetchNodeObject(
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseRotatingImp::fetchNodeObjects(
+    std::vector<uint256 const*> const& hashes,
+    std::uint32_t)
+{
+    auto fetchBatch = [&](std::shared_ptr<Backend> const& backend,
+                          std::vector<uint256 const*> const& keys) {
+        try
+        {
+            return backend->fetchBatch(keys).first;
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.fatal()) << "Exception, " << e.what();
+            Rethrow();
+        }
+    };
+
+    auto [writable, archive] = [&] {
+        std::lock_guard lock(mutex_);
+        return std::make_pair(writableBackend_, archiveBackend_);
+    }();
+
+    // Try to fetch from the writable backend
+    auto results{fetchBatch(writable, hashes)};
+
+    std::vector<uint256 const*> misses;
+    std::vector<std::size_t> missIndexes;
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        if (!results[i])
+        {
+            misses.push_back(hashes[i]);
+            missIndexes.push_back(i);
+        }
+    }
+
+    if (misses.empty())
+        return results;
+
+    // Otherwise try to fetch from the archive backend
+    auto archived{fetchBatch(archive, misses)};
+
+    Batch batch;
+    for (std::size_t i = 0; i < archived.size(); ++i)
+    {
+        if (archived[i])
+        {
+            batch.push_back(archived[i]);
+            results[missIndexes[i]] = std::move(archived[i]);
+        }
+    }
+
+    if (!batch.empty())
+    {
+        {
+            // Refresh the writable backend pointer
+            std::lock_guard lock(mutex_);
+            writable = writableBackend_;
+        }
+
+        // Update writable backend with data from the archive backend
+        auto const begin{std::chrono::steady_clock::now()};
+        writable->storeBatch(batch);
+        updateStoreBatchLatency(std::chrono::steady_clock::now() - begin);
+    }
+
+    return results;
+}
+
 void
 DatabaseRotatingImp::for_each(
     std::function<void(std::shared_ptr<NodeObject>)> f)
@@ -51,6 +51,9 @@ public:
         std::function<std::unique_ptr<NodeStore::Backend>(
             std::string const& writableBackendName)> const& f) override;
 
+    std::size_t
+    copyToWritable(std::vector<uint256 const*> const& hashes) override;
+
     std::string
     getName() const override;
 
@@ -79,17 +82,30 @@ public:
     void
     sweep() override;
 
+    void
+    getCountsJson(Json::Value& obj) override;
+
 private:
     std::shared_ptr<Backend> writableBackend_;
     std::shared_ptr<Backend> archiveBackend_;
     mutable std::mutex mutex_;
 
+    // Memory for the Bloom filter in front of each backend rotated in,
+    // which lets lookups skip a backend that lacks the key. The
+    // backends opened at startup hold unknown keys and go unfiltered.
+    std::size_t const filterBytes_;
+
     std::shared_ptr<NodeObject>
     fetchNodeObject(
         uint256 const& hash,
         std::uint32_t,
         FetchReport& fetchReport) override;
 
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256 const*> const& hashes,
+        std::uint32_t) override;
+
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override;
 };
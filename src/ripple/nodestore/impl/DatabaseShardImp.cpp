@@ -588,7 +588,7 @@ DatabaseShardImp::fetchLedger(uint256 const& hash, std::uint32_t ledgerSeq)
     };
 
     auto ledger{std::make_shared<Ledger>(
-        deserializePrefixedHeader(makeSlice(nodeObject->getData())),
+        deserializePrefixedHeader(nodeObject->getData()),
         app_.config(),
         *app_.getShardFamily())};
 
@@ -1105,8 +1105,12 @@ DatabaseShardImp::store(
 
     auto const nodeObject{
         NodeObject::createObject(type, std::move(data), hash)};
+    auto const begin{std::chrono::steady_clock::now()};
     if (shard->storeNodeObject(nodeObject))
+    {
+        updateStoreLatency(std::chrono::steady_clock::now() - begin);
         storeStats(1, nodeObject->getData().size());
+    }
 }
 
 bool
@@ -1222,6 +1226,21 @@ DatabaseShardImp::getDatabaseImportStatus() const
     return ret;
 }
 
+Json::Value
+DatabaseShardImp::getFinalizeStatus() const
+{
+    Json::Value ret(Json::arrayValue);
+
+    std::lock_guard lock(mutex_);
+    for (auto const& [_, shard] : shards_)
+    {
+        if (shard->getState() == ShardState::finalizing)
+            ret.append(shard->getFinalizeStatus());
+    }
+
+    return ret;
+}
+
 std::optional<std::uint32_t>
 DatabaseShardImp::getDatabaseImportSequence() const
 {
@@ -1277,6 +1296,13 @@ DatabaseShardImp::initConfig(std::lock_guard<std::mutex> const&)
     {
         get_if_exists(section, "max_historical_shards", maxHistoricalShards_);
 
+        std::uint32_t finalizeThreads{1};
+        if (get_if_exists(section, "finalize_threads", finalizeThreads) &&
+            (finalizeThreads < 1 || finalizeThreads > 16))
+        {
+            return fail("'finalize_threads' value out of range");
+        }
+
         Section const& historicalShardPaths =
             config.section(SECTION_HISTORICAL_SHARD_PATHS);
 
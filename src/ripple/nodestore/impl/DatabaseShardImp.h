@@ -135,6 +135,9 @@ public:
     Json::Value
     getDatabaseImportStatus() const override;
 
+    Json::Value
+    getFinalizeStatus() const override;
+
     std::optional<std::uint32_t>
     getDatabaseImportSequence() const override;
 
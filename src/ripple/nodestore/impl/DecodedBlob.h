@@ -52,6 +52,14 @@ public:
     std::shared_ptr<NodeObject>
     createObject();
 
+    /** Create a NodeObject that references this data in place.
+
+        @param owner The buffer holding the value passed to the
+                     constructor. The NodeObject keeps it alive.
+    */
+    std::shared_ptr<NodeObject>
+    createObject(std::shared_ptr<void const> owner);
+
 private:
     bool m_success;
 
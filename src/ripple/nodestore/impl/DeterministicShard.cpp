@@ -25,6 +25,7 @@
 #include <ripple/nodestore/impl/Shard.h>
 #include <ripple/protocol/digest.h>
 #include <fstream>
+#include <limits>
 #include <nudb/detail/format.hpp>
 #include <nudb/nudb.hpp>
 #include <openssl/ripemd.h>
@@ -36,7 +37,8 @@ DeterministicShard::DeterministicShard(
     Application& app,
     boost::filesystem::path const& dir,
     std::uint32_t index,
-    beast::Journal j)
+    beast::Journal j,
+    std::uint64_t maxMemBytes)
     : app_(app)
     , index_(index)
     , dir_(dir / "tmp")
@@ -44,8 +46,11 @@ DeterministicShard::DeterministicShard(
     , j_(j)
     , curMemObjs_(0)
     , maxMemObjs_(
-          app_.getShardStore()->ledgersPerShard() <= 256 ? maxMemObjsTest
-                                                         : maxMemObjsDefault)
+          app_.getShardStore()->ledgersPerShard() <= 256
+              ? maxMemObjsTest
+              : std::numeric_limits<std::uint32_t>::max())
+    , curMemBytes_(0)
+    , maxMemBytes_(maxMemBytes)
 {
 }
 
@@ -153,10 +158,15 @@ make_DeterministicShard(
     boost::filesystem::path const& shardDir,
     std::uint32_t shardIndex,
     Serializer const& finalKey,
-    beast::Journal j)
+    beast::Journal j,
+    std::optional<std::uint64_t> maxMemBytes)
 {
-    std::shared_ptr<DeterministicShard> dShard(
-        new DeterministicShard(app, shardDir, shardIndex, j));
+    std::shared_ptr<DeterministicShard> dShard(new DeterministicShard(
+        app,
+        shardDir,
+        shardIndex,
+        j,
+        maxMemBytes.value_or(DeterministicShard::maxMemBytesDefault)));
     if (!dShard->init(finalKey))
         return {};
     return dShard;
@@ -176,6 +186,7 @@ DeterministicShard::close(bool cancel)
         {
             ctx_->flush();
             curMemObjs_ = 0;
+            curMemBytes_ = 0;
             backend_.reset();
         }
     }
@@ -195,10 +206,12 @@ DeterministicShard::store(std::shared_ptr<NodeObject> const& nodeObject)
         backend_->store(nodeObject);
 
         // Flush to the backend if at threshold
-        if (++curMemObjs_ >= maxMemObjs_)
+        curMemBytes_ += nodeObject->getData().size() + NodeObject::keyBytes;
+        if (++curMemObjs_ >= maxMemObjs_ || curMemBytes_ >= maxMemBytes_)
         {
             ctx_->flush();
             curMemObjs_ = 0;
+            curMemBytes_ = 0;
         }
     }
     catch (std::exception const& e)
@@ -23,6 +23,7 @@
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/nodestore/DummyScheduler.h>
 #include <nudb/nudb.hpp>
+#include <optional>
 #include <set>
 
 namespace ripple {
@@ -33,13 +34,17 @@ namespace NodeStore {
  * 1. The init() method creates temporary folder dir_,
  *    and the deterministic shard is initialized in that folder.
  * 2. The store() method adds object to memory pool.
- * 3. The flush() method stores all objects from memory pool to the shard
- *    located in dir_ in sorted order.
+ * 3. When the memory pool reaches its limit, all objects in it are
+ *    committed to the shard located in dir_ in sorted order.
  * 4. The close(true) method closes the backend and removes the directory.
  */
 class DeterministicShard
 {
-    constexpr static std::uint32_t maxMemObjsDefault = 16384u;
+    // Every commit rewrites the key file buckets it touches and logs their
+    // previous contents first, so the memory pool is bounded by size and
+    // kept large to commit as rarely as possible. The limits take part in
+    // the layout of the files and must be the same on every server.
+    constexpr static std::uint64_t maxMemBytesDefault = 128u * 1024 * 1024;
     constexpr static std::uint32_t maxMemObjsTest = 16u;
 
     /* "SHRD" in ASCII */
@@ -56,12 +61,14 @@ private:
      * @param dir Directory where shard is located
      * @param index Index of the shard
      * @param j Journal to logging
+     * @param maxMemBytes Size of the memory pool that triggers a commit
      */
     DeterministicShard(
         Application& app,
         boost::filesystem::path const& dir,
         std::uint32_t index,
-        beast::Journal j);
+        beast::Journal j,
+        std::uint64_t maxMemBytes);
 
     /** Initializes the deterministic shard.
      *
@@ -97,7 +104,7 @@ public:
      * @param nodeObject The node object to store
      * @return true on success.
      * @note Flushes all objects in memory to the backend when the number
-     *       of node objects held in memory exceed a threshold
+     *       or size of node objects held in memory exceed a threshold
      */
     [[nodiscard]] bool
     store(std::shared_ptr<NodeObject> const& nodeObject);
@@ -138,13 +145,20 @@ private:
     // Maximum number of in-cache objects
     std::uint32_t const maxMemObjs_;
 
+    // Current number of in-cache bytes
+    std::uint64_t curMemBytes_;
+
+    // Maximum number of in-cache bytes
+    std::uint64_t const maxMemBytes_;
+
     friend std::shared_ptr<DeterministicShard>
     make_DeterministicShard(
         Application& app,
         boost::filesystem::path const& shardDir,
         std::uint32_t shardIndex,
         Serializer const& finalKey,
-        beast::Journal j);
+        beast::Journal j,
+        std::optional<std::uint64_t> maxMemBytes);
 };
 
 /** Creates shared pointer to deterministic shard and initializes it.
@@ -158,6 +172,8 @@ private:
  *        last ledger sequence in the shard (32 bit)
  *        hash of last ledger (256 bits)
  * @param j Journal to logging
+ * @param maxMemBytes Overrides the size of the memory pool that triggers
+ *        a commit. Only for tests; the default is part of the file layout.
  * @return Shared pointer to deterministic shard or {} in case of error.
  */
 std::shared_ptr<DeterministicShard>
@@ -166,7 +182,8 @@ make_DeterministicShard(
     boost::filesystem::path const& shardDir,
     std::uint32_t shardIndex,
     Serializer const& finalKey,
-    beast::Journal j);
+    beast::Journal j,
+    std::optional<std::uint64_t> maxMemBytes = std::nullopt);
 
 }  // namespace NodeStore
 }  // namespace ripple
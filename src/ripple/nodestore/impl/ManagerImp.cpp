@@ -19,6 +19,7 @@
 
 #include <ripple/nodestore/impl/DatabaseNodeImp.h>
 #include <ripple/nodestore/impl/ManagerImp.h>
+#include <ripple/nodestore/impl/TieredCache.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -78,8 +79,21 @@ ManagerImp::make_Database(
 {
     auto backend{make_Backend(config, burstSize, scheduler, journal)};
     backend->open();
+
+    std::unique_ptr<TieredCache> tieredCache;
+    if (config.exists("tiered_cache_path"))
+    {
+        tieredCache = std::make_unique<TieredCache>(
+            config, burstSize, scheduler, journal);
+    }
+
     return std::make_unique<DatabaseNodeImp>(
-        scheduler, readThreads, std::move(backend), config, journal);
+        scheduler,
+        readThreads,
+        std::move(backend),
+        std::move(tieredCache),
+        config,
+        journal);
 }
 
 void
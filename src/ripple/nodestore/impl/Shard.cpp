@@ -27,10 +27,14 @@
 #include <ripple/nodestore/impl/DeterministicShard.h>
 #include <ripple/nodestore/impl/Shard.h>
 #include <ripple/protocol/digest.h>
+#include <ripple/protocol/jss.h>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <algorithm>
+#include <thread>
+
 namespace ripple {
 namespace NodeStore {
 
@@ -545,6 +549,29 @@ Shard::getWriteLoad()
     return backend_->getWriteLoad();
 }
 
+Json::Value
+Shard::getFinalizeStatus() const
+{
+    using namespace std::chrono;
+
+    std::uint32_t const verified{progress_};
+    steady_clock::duration elapsed;
+    {
+        std::lock_guard lock(mutex_);
+        elapsed = steady_clock::now() - finalizeStart_;
+    }
+    auto const ms{duration_cast<milliseconds>(elapsed).count()};
+
+    Json::Value ret(Json::objectValue);
+    ret[jss::index] = index_;
+    ret[jss::percent_progress] =
+        static_cast<std::uint32_t>(calculatePercent(verified, maxLedgers_));
+    ret[jss::ledgers_verified] = verified;
+    ret[jss::ledgers_per_second] =
+        ms > 0 ? static_cast<std::uint32_t>(verified * 1000ull / ms) : 0u;
+    return ret;
+}
+
 bool
 Shard::isLegacy() const
 {
@@ -663,57 +690,155 @@ Shard::finalize(bool writeSQLite, std::optional<uint256> const& referenceHash)
     if (!dShard)
         return fail("Failed to create deterministic shard");
 
+    // A ledger read from the backend along with the node objects
+    // its verification produced, held until they can be stored
+    struct Verified
+    {
+        std::shared_ptr<Ledger const> ledger;
+        std::shared_ptr<NodeObject> header;
+        std::vector<std::shared_ptr<NodeObject>> nodeObjects;
+        bool valid{false};
+    };
+
+    // The deterministic shard must receive node objects in the same order
+    // on every server. Ledgers are therefore verified concurrently in
+    // batches, but their node objects are stored in walk order.
+    std::size_t const threads{std::clamp<std::size_t>(
+        get<std::size_t>(
+            config.section(ConfigSection::shardDatabase()),
+            "finalize_threads",
+            1),
+        1,
+        16)};
+    std::size_t const batchSize{threads * 8};
+    std::vector<Verified> batch;
+    batch.reserve(batchSize);
+
+    {
+        std::lock_guard lock(mutex_);
+        finalizeStart_ = std::chrono::steady_clock::now();
+    }
+
     // Start with the last ledger in the shard and walk backwards from
     // child to parent until we reach the first ledger
     ledgerSeq = lastSeq_;
     while (ledgerSeq >= firstSeq_)
     {
-        if (stop_)
-            return false;
+        // Walk a batch of ledger headers. Each header names its parent,
+        // so this part of the walk is serial.
+        batch.clear();
+        while (ledgerSeq >= firstSeq_ && batch.size() < batchSize)
+        {
+            if (stop_)
+                return false;
+
+            auto nodeObject{verifyFetch(hash)};
+            if (!nodeObject)
+                return fail("invalid ledger");
+
+            ledger = std::make_shared<Ledger>(
+                deserializePrefixedHeader(nodeObject->getData()),
+                config,
+                shardFamily);
+            if (ledger->info().seq != ledgerSeq)
+                return fail("invalid ledger sequence");
+            if (ledger->info().hash != hash)
+                return fail("invalid ledger hash");
+
+            ledger->stateMap().setLedgerSeq(ledgerSeq);
+            ledger->txMap().setLedgerSeq(ledgerSeq);
+            ledger->setImmutable(config);
+            if (!ledger->stateMap().fetchRoot(
+                    SHAMapHash{ledger->info().accountHash}, nullptr))
+            {
+                return fail("missing root STATE node");
+            }
+            if (ledger->info().txHash.isNonZero() &&
+                !ledger->txMap().fetchRoot(
+                    SHAMapHash{ledger->info().txHash}, nullptr))
+            {
+                return fail("missing root TXN node");
+            }
+
+            hash = ledger->info().parentHash;
+            batch.push_back({std::move(ledger), std::move(nodeObject)});
+            --ledgerSeq;
+        }
 
-        auto nodeObject{verifyFetch(hash)};
-        if (!nodeObject)
-            return fail("invalid ledger");
-
-        ledger = std::make_shared<Ledger>(
-            deserializePrefixedHeader(makeSlice(nodeObject->getData())),
-            config,
-            shardFamily);
-        if (ledger->info().seq != ledgerSeq)
-            return fail("invalid ledger sequence");
-        if (ledger->info().hash != hash)
-            return fail("invalid ledger hash");
-
-        ledger->stateMap().setLedgerSeq(ledgerSeq);
-        ledger->txMap().setLedgerSeq(ledgerSeq);
-        ledger->setImmutable(config);
-        if (!ledger->stateMap().fetchRoot(
-                SHAMapHash{ledger->info().accountHash}, nullptr))
+        std::size_t first{0};
+        if (!next)
         {
-            return fail("missing root STATE node");
+            // The last ledger has no child to compare against and its
+            // state map is walked in full, stream it rather than buffer it
+            auto& v{batch.front()};
+            v.valid = verifyLedger(
+                v.ledger, nullptr, [&dShard](auto const& nodeObject) {
+                    return dShard->store(nodeObject);
+                });
+            first = 1;
         }
-        if (ledger->info().txHash.isNonZero() &&
-            !ledger->txMap().fetchRoot(
-                SHAMapHash{ledger->info().txHash}, nullptr))
+
+        // Verify the Merkle trees of the batch. The tree node cache is kept
+        // for the whole batch so inner nodes shared by adjacent ledgers are
+        // only read once.
+        std::atomic<std::size_t> index{first};
+        auto work = [&]() {
+            for (std::size_t i; (i = index++) < batch.size();)
+            {
+                auto& v{batch[i]};
+                v.valid = verifyLedger(
+                    v.ledger,
+                    i == 0 ? next : batch[i - 1].ledger,
+                    [&v](auto const& nodeObject) {
+                        v.nodeObjects.push_back(nodeObject);
+                        return true;
+                    });
+            }
+        };
+
+        std::vector<std::thread> workers;
+        auto const count{std::min(threads, batch.size() - first)};
+        if (count > 1)
         {
-            return fail("missing root TXN node");
+            workers.reserve(count - 1);
+            for (std::size_t i = 1; i < count; ++i)
+                workers.emplace_back(work);
         }
 
-        if (!verifyLedger(ledger, next, dShard))
-            return fail("failed to verify ledger");
+        work();
 
-        if (!dShard->store(nodeObject))
-            return fail("failed to store node object");
+        for (auto& worker : workers)
+            worker.join();
 
-        if (writeSQLite && !storeSQLite(ledger))
-            return fail("failed storing to SQLite databases");
+        if (stop_)
+            return false;
+
+        for (auto& v : batch)
+        {
+            hash = v.ledger->info().hash;
+            ledgerSeq = v.ledger->info().seq;
+
+            if (!v.valid)
+                return fail("failed to verify ledger");
 
-        hash = ledger->info().parentHash;
-        next = std::move(ledger);
+            for (auto const& nodeObject : v.nodeObjects)
+            {
+                if (!dShard->store(nodeObject))
+                    return fail("failed to store node object");
+            }
+
+            if (!dShard->store(v.header))
+                return fail("failed to store node object");
 
-        // Update progress
-        progress_ = maxLedgers_ - (ledgerSeq - firstSeq_);
+            if (writeSQLite && !storeSQLite(v.ledger))
+                return fail("failed storing to SQLite databases");
+
+            // Update progress
+            progress_ = maxLedgers_ - (ledgerSeq - firstSeq_);
+        }
 
+        hash = batch.back().ledger->info().parentHash;
+        next = std::move(batch.back().ledger);
         --ledgerSeq;
 
         fullBelowCache->reset();
@@ -1094,7 +1219,8 @@ bool
 Shard::verifyLedger(
     std::shared_ptr<Ledger const> const& ledger,
     std::shared_ptr<Ledger const> const& next,
-    std::shared_ptr<DeterministicShard> const& dShard) const
+    std::function<bool(std::shared_ptr<NodeObject> const&)> const& onVerified)
+    const
 {
     auto fail = [j = j_, index = index_, &ledger](std::string const& msg) {
         JLOG(j.error()) << "shard " << index << ". " << msg
@@ -1113,12 +1239,12 @@ Shard::verifyLedger(
         return fail("Invalid ledger account hash");
 
     bool error{false};
-    auto visit = [this, &error, &dShard](SHAMapTreeNode const& node) {
+    auto visit = [this, &error, &onVerified](SHAMapTreeNode const& node) {
         if (stop_)
             return false;
 
         auto nodeObject{verifyFetch(node.getHash().as_uint256())};
-        if (!nodeObject || !dShard->store(nodeObject))
+        if (!nodeObject || !onVerified(nodeObject))
             error = true;
 
         return !error;
@@ -1195,7 +1321,7 @@ Shard::verifyFetch(uint256 const& hash) const
             case ok:
                 // Verify that the hash of node object matches the payload
                 if (nodeObject->getHash() !=
-                    sha512Half(makeSlice(nodeObject->getData())))
+                    sha512Half(nodeObject->getData()))
                     return fail("Node object hash does not match payload");
                 return nodeObject;
             case notFound:
@@ -26,6 +26,7 @@
 #include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/RangeSet.h>
 #include <ripple/core/DatabaseCon.h>
+#include <ripple/json/json_value.h>
 #include <ripple/nodestore/NodeObject.h>
 #include <ripple/nodestore/Scheduler.h>
 #include <ripple/nodestore/impl/DeterministicShard.h>
@@ -179,6 +180,12 @@ public:
         return calculatePercent(progress_, maxLedgers_);
     }
 
+    /** Returns the progress and throughput of a finalization, reported
+        while the shard is in the finalizing state.
+     */
+    [[nodiscard]] Json::Value
+    getFinalizeStatus() const;
+
     [[nodiscard]] std::int32_t
     getWriteLoad();
 
@@ -188,7 +195,8 @@ public:
     isLegacy() const;
 
     /** Finalize shard by walking its ledgers, verifying each Merkle tree and
-       creating a deterministic backend.
+       creating a deterministic backend. The Merkle trees are verified by
+       up to `finalize_threads` threads from the [shard_db] section.
 
         @param writeSQLite If true, SQLite entries will be rewritten using
         verified backend data.
@@ -353,6 +361,10 @@ private:
     // Determines if the shard directory should be removed in the destructor
     std::atomic<bool> removeOnDestroy_{false};
 
+    // The time the current finalization started
+    // Lock over mutex_ required
+    std::chrono::steady_clock::time_point finalizeStart_;
+
     // The time of the last access of a shard with a finalized state
     std::chrono::steady_clock::time_point lastAccess_;
 
@@ -375,12 +387,14 @@ private:
     setFileStats(std::lock_guard<std::mutex> const&);
 
     // Verify this ledger by walking its SHAMaps and verifying its Merkle trees
-    // Every node object verified will be stored in the deterministic shard
+    // Every node object verified is passed to onVerified, which returns
+    // false to fail the verification
     [[nodiscard]] bool
     verifyLedger(
         std::shared_ptr<Ledger const> const& ledger,
         std::shared_ptr<Ledger const> const& next,
-        std::shared_ptr<DeterministicShard> const& dShard) const;
+        std::function<bool(std::shared_ptr<NodeObject> const&)> const&
+            onVerified) const;
 
     // Fetches from backend and log errors based on status codes
     [[nodiscard]] std::shared_ptr<NodeObject>
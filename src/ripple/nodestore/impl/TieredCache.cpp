@@ -0,0 +1,238 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/basics/contract.h>
+#include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/TieredCache.h>
+#include <ripple/protocol/jss.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <cassert>
+
+namespace ripple {
+namespace NodeStore {
+
+namespace {
+
+// Prefix of the directory names used for generations
+std::string const generationPrefix{"generation."};
+
+}  // namespace
+
+TieredCache::TieredCache(
+    Section const& config,
+    std::size_t burstSize,
+    Scheduler& scheduler,
+    beast::Journal j)
+    : type_(get<std::string>(config, "tiered_cache_type", "NuDB"))
+    , dir_(get<std::string>(config, "tiered_cache_path"))
+    , capacity_(megabytes(get<std::uint64_t>(config, "tiered_cache_mb", 0)))
+    , burstSize_(burstSize)
+    , scheduler_(scheduler)
+    , j_(j)
+{
+    if (dir_.empty())
+        Throw<std::runtime_error>("tiered_cache_path must not be empty");
+    if (capacity_ == 0)
+        Throw<std::runtime_error>("tiered_cache_mb must be greater than 0");
+    if (!Manager::instance().find(type_))
+        Throw<std::runtime_error>("Unknown tiered_cache_type " + type_);
+
+    // Remove generations left over from a previous run. Only directories
+    // the cache creates are removed, in case the path is shared.
+    using namespace boost::filesystem;
+    if (exists(dir_))
+    {
+        if (!is_directory(dir_))
+            Throw<std::runtime_error>("tiered_cache_path must be a directory");
+
+        for (auto const& entry : directory_iterator(dir_))
+        {
+            if (is_directory(entry) &&
+                boost::starts_with(
+                    entry.path().filename().string(), generationPrefix))
+            {
+                remove_all(entry.path());
+            }
+        }
+    }
+
+    auto previous{makeGeneration()};
+    auto current{makeGeneration()};
+
+    std::lock_guard lock(mutex_);
+    previous_ = std::move(previous);
+    current_ = std::move(current);
+}
+
+TieredCache::~TieredCache()
+{
+    std::lock_guard lock(mutex_);
+    current_->setDeletePath();
+    previous_->setDeletePath();
+}
+
+std::shared_ptr<NodeObject>
+TieredCache::fetch(uint256 const& hash)
+{
+    auto [current, previous] = [&] {
+        std::lock_guard lock(mutex_);
+        return std::make_pair(current_, previous_);
+    }();
+
+    ++readsTotal_;
+
+    auto fetch = [&](std::shared_ptr<Backend> const& backend) {
+        std::shared_ptr<NodeObject> nodeObject;
+        try
+        {
+            if (backend->fetch(hash.data(), &nodeObject) != ok)
+                nodeObject.reset();
+        }
+        catch (std::exception const& e)
+        {
+            // The primary backend still has the object
+            JLOG(j_.warn()) << "Tiered cache fetch failed: " << e.what();
+            nodeObject.reset();
+        }
+        return nodeObject;
+    };
+
+    auto nodeObject{fetch(current)};
+    if (!nodeObject)
+    {
+        nodeObject = fetch(previous);
+
+        // Keep objects that are still being read
+        if (nodeObject)
+            insert(nodeObject);
+    }
+
+    if (nodeObject)
+        ++readsHit_;
+
+    return nodeObject;
+}
+
+void
+TieredCache::insert(std::shared_ptr<NodeObject> const& nodeObject)
+{
+    auto const current = [&] {
+        std::lock_guard lock(mutex_);
+        return current_;
+    }();
+
+    try
+    {
+        current->store(nodeObject);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.warn()) << "Tiered cache store failed: " << e.what();
+        return;
+    }
+
+    auto const size{nodeObject->getData().size() + NodeObject::keyBytes};
+    ++writes_;
+    writtenBytes_ += size;
+
+    // Each generation holds up to half of the capacity
+    if ((currentBytes_ += size) < capacity_ / 2)
+        return;
+
+    // Only one thread rotates. The next generation is built without
+    // holding mutex_, so other fetches and inserts are not blocked.
+    if (rotating_.exchange(true))
+        return;
+
+    {
+        std::lock_guard lock(mutex_);
+
+        // Another thread may have rotated already
+        if (current != current_)
+        {
+            rotating_ = false;
+            return;
+        }
+    }
+
+    std::shared_ptr<Backend> next;
+    try
+    {
+        next = makeGeneration();
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.error()) << "Tiered cache rotation failed: " << e.what();
+        rotating_ = false;
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+
+        // Deleted once the last reader releases it
+        previous_->setDeletePath();
+        previous_ = std::move(current_);
+        current_ = std::move(next);
+        currentBytes_ = 0;
+    }
+    ++rotations_;
+    rotating_ = false;
+}
+
+void
+TieredCache::getCountsJson(Json::Value& obj) const
+{
+    assert(obj.isObject());
+    obj[jss::tiered_cache_reads_total] = std::to_string(readsTotal_);
+    obj[jss::tiered_cache_reads_hit] = std::to_string(readsHit_);
+    obj[jss::tiered_cache_writes] = std::to_string(writes_);
+    obj[jss::tiered_cache_written_bytes] = std::to_string(writtenBytes_);
+    obj[jss::tiered_cache_rotations] = std::to_string(rotations_);
+}
+
+int
+TieredCache::fdRequired() const
+{
+    // A third generation may briefly be open while readers
+    // release the one being deleted
+    std::lock_guard lock(mutex_);
+    return current_->fdRequired() * 3;
+}
+
+std::shared_ptr<Backend>
+TieredCache::makeGeneration()
+{
+    auto const path{dir_ / (generationPrefix + std::to_string(generation_++))};
+
+    Section section;
+    section.set("type", type_);
+    section.set("path", path.string());
+
+    std::shared_ptr<Backend> backend{Manager::instance().make_Backend(
+        section, burstSize_, scheduler_, j_)};
+    backend->open();
+    return backend;
+}
+
+}  // namespace NodeStore
+}  // namespace ripple
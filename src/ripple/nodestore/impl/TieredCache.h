@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_TIEREDCACHE_H_INCLUDED
+#define RIPPLE_NODESTORE_TIEREDCACHE_H_INCLUDED
+
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
+#include <ripple/nodestore/Backend.h>
+#include <ripple/nodestore/Scheduler.h>
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <mutex>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A read-through cache of node objects kept in backends on fast storage.
+
+    Objects read from the primary backend are copied into the current
+    generation. Once it holds half of the configured capacity, the previous
+    generation is deleted and the current one takes its place. Hits in the
+    previous generation are copied forward, so objects that keep being read
+    survive rotation. This evicts by recency on backends, such as NuDB,
+    which cannot delete individual objects.
+
+    The cache is cleared when it is created or destroyed.
+
+    @note fetch and insert can be called concurrently.
+*/
+class TieredCache
+{
+public:
+    TieredCache(
+        Section const& config,
+        std::size_t burstSize,
+        Scheduler& scheduler,
+        beast::Journal j);
+
+    ~TieredCache();
+
+    TieredCache(TieredCache const&) = delete;
+    TieredCache&
+    operator=(TieredCache const&) = delete;
+
+    /** Returns the node object or nullptr if it is not in the cache. */
+    std::shared_ptr<NodeObject>
+    fetch(uint256 const& hash);
+
+    /** Add a node object read from the primary backend. */
+    void
+    insert(std::shared_ptr<NodeObject> const& nodeObject);
+
+    void
+    getCountsJson(Json::Value& obj) const;
+
+    /** Returns the number of file descriptors the cache needs */
+    int
+    fdRequired() const;
+
+private:
+    // Create the backend holding the next generation. Called without
+    // holding mutex_, since creating and opening a backend can be slow.
+    std::shared_ptr<Backend>
+    makeGeneration();
+
+    std::string const type_;
+    boost::filesystem::path const dir_;
+
+    // Total bytes held by both generations
+    std::uint64_t const capacity_;
+
+    std::size_t const burstSize_;
+    Scheduler& scheduler_;
+    beast::Journal const j_;
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<Backend> current_;
+    std::shared_ptr<Backend> previous_;
+
+    // Set while one thread builds the next generation
+    std::atomic<bool> rotating_{false};
+    std::atomic<std::uint64_t> generation_{0};
+
+    // Bytes written to the current generation
+    std::atomic<std::uint64_t> currentBytes_{0};
+
+    std::atomic<std::uint64_t> readsTotal_{0};
+    std::atomic<std::uint64_t> readsHit_{0};
+    std::atomic<std::uint64_t> writes_{0};
+    std::atomic<std::uint64_t> writtenBytes_{0};
+    std::atomic<std::uint64_t> rotations_{0};
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
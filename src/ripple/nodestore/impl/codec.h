@@ -23,14 +23,17 @@
 // Disable lz4 deprecation warning due to incompatibility with clang attributes
 #define LZ4_DISABLE_DEPRECATE_WARNINGS
 
+#include <ripple/basics/Buffer.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/safe_cast.h>
+#include <ripple/nodestore/CodecDictionary.h>
 #include <ripple/nodestore/NodeObject.h>
 #include <ripple/nodestore/impl/varint.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <cstddef>
 #include <cstring>
 #include <lz4.h>
+#include <memory>
 #include <nudb/detail/field.hpp>
 #include <string>
 #include <utility>
@@ -84,6 +87,59 @@ lz4_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
     return result;
 }
 
+template <class BufferFactory>
+std::pair<void const*, std::size_t>
+zstd_decompress(
+    void const* in,
+    std::size_t in_size,
+    CodecDictionary const* dict,
+    BufferFactory&& bf)
+{
+    using namespace nudb::detail;
+    std::pair<void const*, std::size_t> result;
+    std::uint8_t const* p = reinterpret_cast<std::uint8_t const*>(in);
+    std::size_t id;
+    auto n = read_varint(p, in_size, id);
+    if (n == 0)
+        Throw<std::runtime_error>("zstd decompress: n == 0");
+    if (!dict || dict->id() != id)
+        Throw<std::runtime_error>(
+            "zstd decompress: missing dictionary " + std::to_string(id));
+    p += n;
+    in_size -= n;
+    n = read_varint(p, in_size, result.second);
+    if (n == 0)
+        Throw<std::runtime_error>("zstd decompress: n == 0");
+    p += n;
+    in_size -= n;
+    void* const out = bf(result.second);
+    result.first = out;
+    if (dict->decompress(p, in_size, out, result.second) != result.second)
+        Throw<std::runtime_error>("zstd decompress: short output");
+    return result;
+}
+
+template <class BufferFactory>
+std::pair<void const*, std::size_t>
+zstd_compress(
+    void const* in,
+    std::size_t in_size,
+    CodecDictionary const& dict,
+    BufferFactory&& bf)
+{
+    using namespace nudb::detail;
+    std::pair<void const*, std::size_t> result;
+    std::array<std::uint8_t, 2 * varint_traits<std::size_t>::max> vi;
+    auto const n = write_varint(vi.data(), dict.id());
+    auto const m = write_varint(vi.data() + n, in_size);
+    auto const out_max = CodecDictionary::compressBound(in_size);
+    std::uint8_t* out = reinterpret_cast<std::uint8_t*>(bf(n + m + out_max));
+    result.first = out;
+    std::memcpy(out, vi.data(), n + m);
+    result.second = n + m + dict.compress(in, in_size, out + n + m, out_max);
+    return result;
+}
+
 //------------------------------------------------------------------------------
 
 /*
@@ -93,11 +149,21 @@ lz4_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
     1 = lz4 compressed
     2 = inner node compressed
     3 = full inner node
+    4 = zstd compressed with a dictionary
 */
 
+/** Decode a stored object.
+
+    @param dict The dictionary embedded in the store, if any. Objects
+                of type 4 can only be decoded with it.
+*/
 template <class BufferFactory>
 std::pair<void const*, std::size_t>
-nodeobject_decompress(void const* in, std::size_t in_size, BufferFactory&& bf)
+nodeobject_decompress(
+    void const* in,
+    std::size_t in_size,
+    BufferFactory&& bf,
+    CodecDictionary const* dict = nullptr)
 {
     using namespace nudb::detail;
 
@@ -191,6 +257,11 @@ nodeobject_decompress(void const* in, std::size_t in_size, BufferFactory&& bf)
             write(os, is(512), 512);
             break;
         }
+        case 4:  // zstd with a dictionary
+        {
+            result = zstd_decompress(p, in_size, dict, bf);
+            break;
+        }
         default:
             Throw<std::runtime_error>(
                 "nodeobject codec: bad type=" + std::to_string(type));
@@ -198,6 +269,31 @@ nodeobject_decompress(void const* in, std::size_t in_size, BufferFactory&& bf)
     return result;
 }
 
+/** A BufferFactory whose buffer is reference counted.
+
+    Decompressing into it lets the NodeObject made from the result
+    reference the decompressed data instead of copying it.
+*/
+class SharedBufferFactory
+{
+    std::shared_ptr<Buffer> buffer_;
+
+public:
+    void*
+    operator()(std::size_t n)
+    {
+        buffer_ = std::make_shared<Buffer>(n);
+        return buffer_->data();
+    }
+
+    /** Returns the buffer, or null if none was needed. */
+    std::shared_ptr<Buffer>
+    release()
+    {
+        return std::move(buffer_);
+    }
+};
+
 template <class = void>
 void const*
 zero32()
@@ -206,9 +302,18 @@ zero32()
     return v.data();
 }
 
+/** Encode an object for storage.
+
+    @param dict If set, objects other than inner nodes are compressed
+                with this dictionary instead of lz4.
+*/
 template <class BufferFactory>
 std::pair<void const*, std::size_t>
-nodeobject_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
+nodeobject_compress(
+    void const* in,
+    std::size_t in_size,
+    BufferFactory&& bf,
+    CodecDictionary const* dict = nullptr)
 {
     using std::runtime_error;
     using namespace nudb::detail;
@@ -272,7 +377,7 @@ nodeobject_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
 
     std::array<std::uint8_t, varint_traits<std::size_t>::max> vi;
 
-    constexpr std::size_t codecType = 1;
+    std::size_t const codecType = dict ? 4 : 1;
     auto const vn = write_varint(vi.data(), codecType);
     std::pair<void const*, std::size_t> result;
     switch (codecType)
@@ -291,6 +396,19 @@ nodeobject_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
             result.second = vn + lzr.second;
             break;
         }
+        case 4:  // zstd with a dictionary
+        {
+            std::uint8_t* p;
+            auto const zr = NodeStore::zstd_compress(
+                in, in_size, *dict, [&p, &vn, &bf](std::size_t n) {
+                    p = reinterpret_cast<std::uint8_t*>(bf(vn + n));
+                    return p + vn;
+                });
+            std::memcpy(p, vi.data(), vn);
+            result.first = p;
+            result.second = vn + zr.second;
+            break;
+        }
         default:
             Throw<std::logic_error>(
                 "nodeobject codec: unknown=" + std::to_string(codecType));
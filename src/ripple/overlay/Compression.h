@@ -33,7 +33,7 @@ std::size_t constexpr headerBytesCompressed = 10;
 
 // All values other than 'none' must have the high bit. The low order four bits
 // must be 0.
-enum class Algorithm : std::uint8_t { None = 0x00, LZ4 = 0x90 };
+enum class Algorithm : std::uint8_t { None = 0x00, LZ4 = 0x90, ZSTD = 0xA0 };
 
 enum class Compressed : std::uint8_t { On, Off };
 
@@ -59,6 +59,9 @@ decompress(
         if (algorithm == Algorithm::LZ4)
             return ripple::compression_algorithms::lz4Decompress(
                 in, inSize, decompressed, decompressedSize);
+        else if (algorithm == Algorithm::ZSTD)
+            return ripple::compression_algorithms::zstdDecompress(
+                in, inSize, decompressed, decompressedSize);
         else
         {
             JLOG(debugLog().warn())
@@ -95,6 +98,9 @@ compress(
         if (algorithm == Algorithm::LZ4)
             return ripple::compression_algorithms::lz4Compress(
                 in, inSize, std::forward<BufferFactory>(bf));
+        else if (algorithm == Algorithm::ZSTD)
+            return ripple::compression_algorithms::zstdCompress(
+                in, inSize, std::forward<BufferFactory>(bf));
         else
         {
             JLOG(debugLog().warn()) << "compress: invalid compression algorithm"
@@ -28,13 +28,19 @@
 #include <boost/asio/buffers_iterator.hpp>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <type_traits>
+#include <vector>
 
 namespace ripple {
 
+class JobQueue;
+
 constexpr std::size_t maximiumMessageSize = megabytes(64);
 
 // VFALCO NOTE If we forward declare Message and write out shared_ptr
@@ -86,6 +92,30 @@ public:
     std::vector<uint8_t> const&
     getBuffer(Compressed tryCompressed);
 
+    /** Retrieve the packed message data compressed with an algorithm.
+     * The message is compressed on the calling thread unless it has been
+     * already. If the message is not compressible then the uncompressed
+     * buffer is returned.
+     * @param algorithm Algorithm to compress with, None for uncompressed
+     * @return Payload buffer
+     */
+    std::vector<uint8_t> const&
+    getBuffer(Algorithm algorithm);
+
+    /** Compress a large message on the job queue instead of on the caller.
+     * Messages to many peers are compressed once, by the first peer to ask.
+     * @param algorithm Algorithm to compress with
+     * @param jobQueue Job queue to compress on
+     * @param onReady Called from the job queue once compressed
+     * @return true if getBuffer(algorithm) may be called right away, in
+     *     which case onReady is not called
+     */
+    bool
+    compressAsync(
+        Algorithm algorithm,
+        JobQueue& jobQueue,
+        std::function<void()> onReady);
+
     /** Get the traffic category */
     std::size_t
     getCategory() const
@@ -101,10 +131,23 @@ public:
     }
 
 private:
+    /** The message compressed with one algorithm */
+    struct CompressedBuffer
+    {
+        std::vector<uint8_t> buffer;
+        std::once_flag once;
+        std::atomic<bool> done{false};
+
+        // Protected by Message::mutex_
+        bool queued = false;
+        std::vector<std::function<void()>> waiters;
+    };
+
     std::vector<uint8_t> buffer_;
-    std::vector<uint8_t> bufferCompressed_;
+    CompressedBuffer lz4_;
+    CompressedBuffer zstd_;
+    std::mutex mutex_;
     std::size_t category_;
-    std::once_flag once_flag_;
     std::optional<PublicKey> validatorKey_;
 
     /** Set the payload header
@@ -112,7 +155,7 @@ private:
      * @param payloadBytes Size of the payload excluding the header size
      * @param type Protocol message type
      * @param compression Compression algorithm used in compression,
-     *   currently LZ4 only. If None then the message is uncompressed.
+     *   LZ4 or ZSTD. If None then the message is uncompressed.
      * @param uncompressedBytes Size of the uncompressed message
      */
     void
@@ -126,9 +169,19 @@ private:
     /** Try to compress the payload.
      * Can be called concurrently by multiple peers but is compressed once.
      * If the message is not compressible then the serialized buffer_ is used.
+     * @param algorithm Compression algorithm to use
+     * @return The buffer holding the compressed payload, empty if the
+     *     message is not compressible
      */
+    CompressedBuffer&
+    compress(Algorithm algorithm);
+
+    void
+    compress(Algorithm algorithm, std::vector<uint8_t>& bufferCompressed);
+
+    /** Compress on the job queue and notify the waiting peers. */
     void
-    compress();
+    onCompressJob(Algorithm algorithm);
 
     /** Get the message type from the payload header.
      * First four bytes are the compression/algorithm flag and the payload size.
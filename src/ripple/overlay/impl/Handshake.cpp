@@ -78,7 +78,8 @@ makeFeaturesRequestHeader(
 {
     std::stringstream str;
     if (comprEnabled)
-        str << FEATURE_COMPR << "=lz4" << DELIM_FEATURE;
+        str << FEATURE_COMPR << "=" << COMPR_ZSTD << DELIM_VALUE
+            << COMPR_LZ4 << DELIM_FEATURE;
     if (vpReduceRelayEnabled)
         str << FEATURE_VPRR << "=1";
     if (ledgerReplayEnabled)
@@ -94,8 +95,17 @@ makeFeaturesResponseHeader(
     bool ledgerReplayEnabled)
 {
     std::stringstream str;
-    if (comprEnabled && isFeatureValue(headers, FEATURE_COMPR, "lz4"))
-        str << FEATURE_COMPR << "=lz4" << DELIM_FEATURE;
+    switch (peerCompressionAlgorithm(headers, comprEnabled))
+    {
+        case compression::Algorithm::ZSTD:
+            str << FEATURE_COMPR << "=" << COMPR_ZSTD << DELIM_FEATURE;
+            break;
+        case compression::Algorithm::LZ4:
+            str << FEATURE_COMPR << "=" << COMPR_LZ4 << DELIM_FEATURE;
+            break;
+        case compression::Algorithm::None:
+            break;
+    }
     if (vpReduceRelayEnabled && featureEnabled(headers, FEATURE_VPRR))
         str << FEATURE_VPRR << "=1";
     if (ledgerReplayEnabled && featureEnabled(headers, FEATURE_LEDGER_REPLAY))
@@ -22,6 +22,7 @@
 
 #include <ripple/app/main/Application.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/overlay/Compression.h>
 #include <ripple/overlay/impl/ProtocolVersion.h>
 #include <ripple/protocol/BuildInfo.h>
 #include <boost/asio/ip/tcp.hpp>
@@ -141,6 +142,14 @@ static constexpr char FEATURE_LEDGER_REPLAY[] =
 static constexpr char DELIM_FEATURE[] = ";";
 static constexpr char DELIM_VALUE[] = ",";
 
+// Values of the compression feature. The zstd value carries the version
+// of its frame format, which is frozen once released: version 1 frames
+// are plain zstd frames compressed without a dictionary. Adding a
+// dictionary, or any other change that a version 1 peer cannot decode,
+// needs a new value, offered alongside the old one.
+static constexpr char COMPR_ZSTD[] = "zstd1";
+static constexpr char COMPR_LZ4[] = "lz4";
+
 /** Get feature's header value
    @param headers request/response header
    @param feature name
@@ -208,6 +217,24 @@ peerFeatureEnabled(
     return config && peerFeatureEnabled(request, feature, "1", config);
 }
 
+/** Get the compression algorithm to use with a peer. ZSTD is preferred to
+    LZ4 when the http header offers both.
+   @tparam headers request (inbound) or response (outbound) header
+   @param request http headers
+   @param config compression's configuration value
+   @return the algorithm, or None if compression is disabled
+ */
+template <typename headers>
+compression::Algorithm
+peerCompressionAlgorithm(headers const& request, bool config)
+{
+    if (peerFeatureEnabled(request, FEATURE_COMPR, COMPR_ZSTD, config))
+        return compression::Algorithm::ZSTD;
+    if (peerFeatureEnabled(request, FEATURE_COMPR, COMPR_LZ4, config))
+        return compression::Algorithm::LZ4;
+    return compression::Algorithm::None;
+}
+
 /** Make request header X-Protocol-Ctl value with supported features
    @param comprEnabled if true then compression feature is enabled
    @param vpReduceRelayEnabled if true then reduce-relay feature is enabled
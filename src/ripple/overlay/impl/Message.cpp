@@ -17,8 +17,10 @@
 */
 //==============================================================================
 
+#include <ripple/core/JobQueue.h>
 #include <ripple/overlay/Message.h>
 #include <ripple/overlay/impl/TrafficCount.h>
+#include <ripple/overlay/impl/Tuning.h>
 #include <cstdint>
 
 namespace ripple {
@@ -64,8 +66,19 @@ Message::totalSize(::google::protobuf::Message const& message)
     return messageSize(message) + compression::headerBytes;
 }
 
+Message::CompressedBuffer&
+Message::compress(Algorithm algorithm)
+{
+    auto& compressed = algorithm == Algorithm::ZSTD ? zstd_ : lz4_;
+    std::call_once(compressed.once, [&] {
+        compress(algorithm, compressed.buffer);
+        compressed.done = true;
+    });
+    return compressed;
+}
+
 void
-Message::compress()
+Message::compress(Algorithm algorithm, std::vector<uint8_t>& bufferCompressed)
 {
     using namespace ripple::compression;
     auto const messageBytes = buffer_.size() - headerBytes;
@@ -113,26 +126,43 @@ Message::compress()
             payload,
             messageBytes,
             [&](std::size_t inSize) {  // size of required compressed buffer
-                bufferCompressed_.resize(inSize + headerBytesCompressed);
-                return (bufferCompressed_.data() + headerBytesCompressed);
-            });
+                bufferCompressed.resize(inSize + headerBytesCompressed);
+                return (bufferCompressed.data() + headerBytesCompressed);
+            },
+            algorithm);
 
         if (compressedSize <
             (messageBytes - (headerBytesCompressed - headerBytes)))
         {
-            bufferCompressed_.resize(headerBytesCompressed + compressedSize);
+            bufferCompressed.resize(headerBytesCompressed + compressedSize);
+            // The bound the buffer was allocated with can be far larger
+            bufferCompressed.shrink_to_fit();
             setHeader(
-                bufferCompressed_.data(),
+                bufferCompressed.data(),
                 compressedSize,
                 type,
-                Algorithm::LZ4,
+                algorithm,
                 messageBytes);
         }
         else
-            bufferCompressed_.resize(0);
+            std::vector<uint8_t>().swap(bufferCompressed);
     }
 }
 
+void
+Message::onCompressJob(Algorithm algorithm)
+{
+    auto& compressed = compress(algorithm);
+
+    std::vector<std::function<void()>> waiters;
+    {
+        std::lock_guard lock(mutex_);
+        waiters.swap(compressed.waiters);
+    }
+    for (auto const& onReady : waiters)
+        onReady();
+}
+
 /** Set payload header
 
     The header is a variable-sized structure that contains information about
@@ -207,17 +237,63 @@ Message::getBufferSize()
 std::vector<uint8_t> const&
 Message::getBuffer(Compressed tryCompressed)
 {
-    if (tryCompressed == Compressed::Off)
+    return getBuffer(
+        tryCompressed == Compressed::On ? Algorithm::LZ4 : Algorithm::None);
+}
+
+std::vector<uint8_t> const&
+Message::getBuffer(Algorithm algorithm)
+{
+    if (algorithm == Algorithm::None)
         return buffer_;
 
-    std::call_once(once_flag_, &Message::compress, this);
+    auto const& compressed = compress(algorithm).buffer;
 
-    if (bufferCompressed_.size() > 0)
-        return bufferCompressed_;
+    if (compressed.size() > 0)
+        return compressed;
     else
         return buffer_;
 }
 
+bool
+Message::compressAsync(
+    Algorithm algorithm,
+    JobQueue& jobQueue,
+    std::function<void()> onReady)
+{
+    // Small messages are cheaper to compress than to hand off
+    if (algorithm == Algorithm::None ||
+        buffer_.size() < Tuning::compressAsyncBytes)
+        return true;
+
+    auto& compressed = algorithm == Algorithm::ZSTD ? zstd_ : lz4_;
+    if (compressed.done)
+        return true;
+
+    {
+        std::lock_guard lock(mutex_);
+        // The job sets done before it takes the lock to notify the waiters
+        if (compressed.done)
+            return true;
+        compressed.waiters.push_back(std::move(onReady));
+        if (compressed.queued)
+            return false;
+        compressed.queued = true;
+    }
+
+    if (!jobQueue.addJob(
+            jtCOMPRESS,
+            "compressMessage",
+            [self = shared_from_this(), algorithm](Job&) {
+                self->onCompressJob(algorithm);
+            }))
+    {
+        // The job queue is stopping
+        onCompressJob(algorithm);
+    }
+    return false;
+}
+
 int
 Message::getType(std::uint8_t const* in) const
 {
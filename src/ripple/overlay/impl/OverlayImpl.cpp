@@ -138,6 +138,7 @@ OverlayImpl::OverlayImpl(
     , next_id_(1)
     , timer_count_(0)
     , slots_(app, *this)
+    , txVerifier_(app)
     , m_stats(
           std::bind(&OverlayImpl::collect_metrics, this),
           collector,
@@ -699,6 +700,10 @@ OverlayImpl::crawlShards(bool includePublicKey, std::uint32_t relays)
             jv[jss::complete_shards] = shardInfo->finalizedToString();
         if (!shardInfo->incomplete().empty())
             jv[jss::incomplete_shards] = shardInfo->incompleteToString();
+        if (auto finalizing{shardStore->getFinalizeStatus()}; finalizing)
+        {
+            jv[jss::finalizing_shards] = std::move(finalizing);
+        }
     }
 
     if (relays == 0 || size() == 0)
@@ -1447,6 +1452,12 @@ setup_Overlay(BasicConfig const& config)
             if (ec || beast::IP::is_private(setup.public_ip))
                 Throw<std::runtime_error>("Configured public IP is invalid");
         }
+
+        std::int64_t cork = 0;
+        set(cork, "send_cork", section);
+        if (cork < 0 || cork > 10000)
+            Throw<std::runtime_error>("Configured send cork is invalid");
+        setup.sendCork = std::chrono::microseconds(cork);
     }
 
     {
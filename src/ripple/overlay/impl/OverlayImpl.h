@@ -30,6 +30,7 @@
 #include <ripple/overlay/Slot.h>
 #include <ripple/overlay/impl/Handshake.h>
 #include <ripple/overlay/impl/TrafficCount.h>
+#include <ripple/overlay/impl/TransactionVerifier.h>
 #include <ripple/peerfinder/PeerfinderManager.h>
 #include <ripple/resource/ResourceManager.h>
 #include <ripple/rpc/ServerHandler.h>
@@ -128,6 +129,9 @@ private:
 
     reduce_relay::Slots<UptimeClock> slots_;
 
+    // Checks the transactions peers relay
+    TransactionVerifier txVerifier_;
+
     // A message with the list of manifests we send to peers
     std::shared_ptr<Message> manifestMessage_;
     // Used to track whether we need to update the cached list of manifests
@@ -176,6 +180,12 @@ public:
         return setup_;
     }
 
+    TransactionVerifier&
+    txVerifier()
+    {
+        return txVerifier_;
+    }
+
     Handoff
     onHandoff(
         std::unique_ptr<stream_type>&& bundle,
@@ -85,6 +85,7 @@ PeerImp::PeerImp(
     , stream_(*stream_ptr_)
     , strand_(socket_.get_executor())
     , timer_(waitable_timer{socket_.get_executor()})
+    , corkTimer_(waitable_timer{socket_.get_executor()})
     , remote_address_(slot->remote_endpoint())
     , overlay_(overlay)
     , inbound_(true)
@@ -100,14 +101,8 @@ PeerImp::PeerImp(
     , slot_(slot)
     , request_(std::move(request))
     , headers_(request_)
-    , compressionEnabled_(
-          peerFeatureEnabled(
-              headers_,
-              FEATURE_COMPR,
-              "lz4",
-              app_.config().COMPRESSION)
-              ? Compressed::On
-              : Compressed::Off)
+    , compression_(
+          peerCompressionAlgorithm(headers_, app_.config().COMPRESSION))
     , vpReduceRelayEnabled_(peerFeatureEnabled(
           headers_,
           FEATURE_VPRR,
@@ -119,7 +114,7 @@ PeerImp::PeerImp(
     , ledgerReplayMsgHandler_(app, app.getLedgerReplayer())
 {
     JLOG(journal_.debug()) << " compression enabled "
-                           << (compressionEnabled_ == Compressed::On)
+                           << static_cast<int>(compression_)
                            << " vp reduce-relay enabled "
                            << vpReduceRelayEnabled_ << " on " << remote_address_
                            << " " << id_;
@@ -245,11 +240,6 @@ PeerImp::send(std::shared_ptr<Message> const& m)
     if (validator && !squelch_.expireSquelch(*validator))
         return;
 
-    overlay_.reportTraffic(
-        safe_cast<TrafficCount::category>(m->getCategory()),
-        false,
-        static_cast<int>(m->getBuffer(compressionEnabled_).size()));
-
     auto sendq_size = send_queue_.size();
 
     if (sendq_size < Tuning::targetSendQueue)
@@ -267,22 +257,24 @@ PeerImp::send(std::shared_ptr<Message> const& m)
              << " sendq: " << sendq_size;
     }
 
-    send_queue_.push(m);
+    send_queue_.push_back(m);
 
     if (sendq_size != 0)
         return;
 
-    boost::asio::async_write(
-        stream_,
-        boost::asio::buffer(
-            send_queue_.front()->getBuffer(compressionEnabled_)),
-        bind_executor(
+    // Hold the first message of a burst briefly, so that the messages
+    // relayed right after it go out in the same write
+    if (auto const cork = overlay_.setup().sendCork; cork.count() > 0)
+    {
+        error_code ec;
+        corkTimer_.expires_from_now(cork, ec);
+        return corkTimer_.async_wait(bind_executor(
             strand_,
             std::bind(
-                &PeerImp::onWriteMessage,
-                shared_from_this(),
-                std::placeholders::_1,
-                std::placeholders::_2)));
+                &PeerImp::onCork, shared_from_this(), std::placeholders::_1)));
+    }
+
+    startWrite();
 }
 
 void
@@ -436,6 +428,15 @@ PeerImp::json()
         std::to_string(metrics_.recv.average_bytes());
     ret[jss::metrics][jss::avg_bps_sent] =
         std::to_string(metrics_.sent.average_bytes());
+    {
+        auto const writes = writeCount_.load();
+        auto const messages = writeMessages_.load();
+        ret[jss::metrics][jss::total_writes] = std::to_string(writes);
+        ret[jss::metrics][jss::total_msgs_sent] = std::to_string(messages);
+        if (writes != 0)
+            ret[jss::metrics][jss::avg_msgs_per_write] =
+                static_cast<double>(messages) / writes;
+    }
 
     return ret;
 }
@@ -529,6 +530,7 @@ PeerImp::close()
         detaching_ = true;  // DEPRECATED
         error_code ec;
         timer_.cancel(ec);
+        corkTimer_.cancel(ec);
         socket_.close(ec);
         overlay_.incPeerDisconnect();
         if (inbound_)
@@ -896,6 +898,83 @@ PeerImp::onReadMessage(error_code ec, std::size_t bytes_transferred)
                 std::placeholders::_2)));
 }
 
+void
+PeerImp::startWrite()
+{
+    assert(strand_.running_in_this_thread());
+    assert(writing_ == 0 && !send_queue_.empty());
+
+    if (compressing_)
+        return;
+
+    // Gather the queued messages into one write. The stream copies
+    // small buffers together, so they share TLS records and system calls.
+    std::vector<boost::asio::const_buffer> buffers;
+    std::size_t bytes = 0;
+    for (auto const& m : send_queue_)
+    {
+        // Large messages are compressed off the strand. Write what is
+        // ready and resume once the rest is compressed.
+        if (!m->compressAsync(
+                compression_, app_.getJobQueue(), [self = shared_from_this()] {
+                    post(
+                        self->strand_,
+                        std::bind(&PeerImp::onCompressed, self));
+                }))
+        {
+            compressing_ = true;
+            break;
+        }
+
+        auto const& buffer = m->getBuffer(compression_);
+        if (!buffers.empty() &&
+            bytes + buffer.size() > Tuning::sendCoalesceBytes)
+            break;
+        overlay_.reportTraffic(
+            safe_cast<TrafficCount::category>(m->getCategory()),
+            false,
+            static_cast<int>(buffer.size()));
+        buffers.emplace_back(buffer.data(), buffer.size());
+        bytes += buffer.size();
+    }
+    if (buffers.empty())
+        return;
+    writing_ = buffers.size();
+
+    // Timeout on writes only
+    boost::asio::async_write(
+        stream_,
+        buffers,
+        bind_executor(
+            strand_,
+            std::bind(
+                &PeerImp::onWriteMessage,
+                shared_from_this(),
+                std::placeholders::_1,
+                std::placeholders::_2)));
+}
+
+void
+PeerImp::onCork(error_code ec)
+{
+    if (!socket_.is_open())
+        return;
+    if (ec == boost::asio::error::operation_aborted)
+        return;
+    if (writing_ == 0 && !send_queue_.empty())
+        startWrite();
+}
+
+void
+PeerImp::onCompressed()
+{
+    compressing_ = false;
+    if (!socket_.is_open())
+        return;
+    if (writing_ == 0 && !send_queue_.empty())
+        startWrite();
+}
+
 void
 PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
 {
@@ -914,24 +993,14 @@ PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
     }
 
     metrics_.sent.add_message(bytes_transferred);
+    ++writeCount_;
+    writeMessages_ += writing_;
 
-    assert(!send_queue_.empty());
-    send_queue_.pop();
+    assert(send_queue_.size() >= writing_);
+    send_queue_.erase(send_queue_.begin(), send_queue_.begin() + writing_);
+    writing_ = 0;
     if (!send_queue_.empty())
-    {
-        // Timeout on writes only
-        return boost::asio::async_write(
-            stream_,
-            boost::asio::buffer(
-                send_queue_.front()->getBuffer(compressionEnabled_)),
-            bind_executor(
-                strand_,
-                std::bind(
-                    &PeerImp::onWriteMessage,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2)));
-    }
+        return startWrite();
 
     if (gracefulClose_)
     {
@@ -1495,7 +1564,8 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMTransaction> const& m)
             }
         }
 
-        if (app_.getJobQueue().getJobCount(jtTRANSACTION) >
+        if (app_.getJobQueue().getJobCount(jtTRANSACTION) +
+                static_cast<int>(overlay_.txVerifier().size()) >
             app_.config().MAX_TRANSACTIONS)
         {
             overlay_.incJqTransOverflow();
@@ -1508,16 +1578,11 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMTransaction> const& m)
         }
         else
         {
-            app_.getJobQueue().addJob(
-                jtTRANSACTION,
-                "recvTransaction->checkTransaction",
-                [weak = std::weak_ptr<PeerImp>(shared_from_this()),
+            overlay_.txVerifier().add(
+                {std::weak_ptr<PeerImp>(shared_from_this()),
                  flags,
                  checkSignature,
-                 stx](Job&) {
-                    if (auto peer = weak.lock())
-                        peer->checkTransaction(flags, checkSignature, stx);
-                });
+                 stx});
         }
     }
     catch (std::exception const&)
@@ -2447,7 +2512,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMGetObjectByHash> const& m)
                     protocol::TMIndexedObject& newObj = *reply.add_objects();
                     newObj.set_hash(hash.begin(), hash.size());
                     newObj.set_data(
-                        &nodeObject->getData().front(),
+                        nodeObject->getData().data(),
                         nodeObject->getData().size());
 
                     if (obj.has_nodeid())
@@ -2617,33 +2682,30 @@ PeerImp::doFetchPack(const std::shared_ptr<protocol::TMGetObjectByHash>& packet)
         });
 }
 
-void
+std::shared_ptr<Transaction>
 PeerImp::checkTransaction(
-    int flags,
     bool checkSignature,
-    std::shared_ptr<STTx const> const& stx)
+    std::shared_ptr<STTx const> const& stx,
+    Rules const& rules,
+    LedgerIndex validLedgerIndex)
 {
     // VFALCO TODO Rewrite to not use exceptions
     try
     {
         // Expired?
         if (stx->isFieldPresent(sfLastLedgerSequence) &&
-            (stx->getFieldU32(sfLastLedgerSequence) <
-             app_.getLedgerMaster().getValidLedgerIndex()))
+            (stx->getFieldU32(sfLastLedgerSequence) < validLedgerIndex))
         {
             app_.getHashRouter().setFlags(stx->getTransactionID(), SF_BAD);
             charge(Resource::feeUnwantedData);
-            return;
+            return {};
         }
 
         if (checkSignature)
         {
             // Check the signature before handing off to the job queue.
             if (auto [valid, validReason] = checkValidity(
-                    app_.getHashRouter(),
-                    *stx,
-                    app_.getLedgerMaster().getValidatedRules(),
-                    app_.config());
+                    app_.getHashRouter(), *stx, rules, app_.config());
                 valid != Validity::Valid)
             {
                 if (!validReason.empty())
@@ -2655,7 +2717,7 @@ PeerImp::checkTransaction(
                 // Probably not necessary to set SF_BAD, but doesn't hurt.
                 app_.getHashRouter().setFlags(stx->getTransactionID(), SF_BAD);
                 charge(Resource::feeInvalidSignature);
-                return;
+                return {};
             }
         }
         else
@@ -2676,18 +2738,17 @@ PeerImp::checkTransaction(
             }
             app_.getHashRouter().setFlags(stx->getTransactionID(), SF_BAD);
             charge(Resource::feeInvalidSignature);
-            return;
+            return {};
         }
 
-        bool const trusted(flags & SF_TRUSTED);
-        app_.getOPs().processTransaction(
-            tx, trusted, false, NetworkOPs::FailHard::no);
+        return tx;
     }
     catch (std::exception const&)
     {
         app_.getHashRouter().setFlags(stx->getTransactionID(), SF_BAD);
         charge(Resource::feeBadData);
     }
+    return {};
 }
 
 // Called from our JobQueue
@@ -25,6 +25,7 @@
 #include <ripple/basics/Log.h>
 #include <ripple/basics/RangeSet.h>
 #include <ripple/beast/utility/WrappedSink.h>
+#include <ripple/ledger/ReadView.h>
 #include <ripple/nodestore/ShardInfo.h>
 #include <ripple/overlay/Squelch.h>
 #include <ripple/overlay/impl/OverlayImpl.h>
@@ -41,11 +42,12 @@
 #include <boost/thread/shared_mutex.hpp>
 #include <cstdint>
 #include <optional>
-#include <queue>
+#include <deque>
 
 namespace ripple {
 
 struct ValidatorBlobInfo;
+class Transaction;
 
 class PeerImp : public Peer,
                 public std::enable_shared_from_this<PeerImp>,
@@ -65,7 +67,7 @@ private:
     using endpoint_type = boost::asio::ip::tcp::endpoint;
     using waitable_timer =
         boost::asio::basic_waitable_timer<std::chrono::steady_clock>;
-    using Compressed = compression::Compressed;
+    using Algorithm = compression::Algorithm;
 
     Application& app_;
     id_t const id_;
@@ -78,6 +80,7 @@ private:
     stream_type& stream_;
     boost::asio::strand<boost::asio::executor> strand_;
     waitable_timer timer_;
+    waitable_timer corkTimer_;
 
     // Updated at each stage of the connection process to reflect
     // the current conditions as closely as possible.
@@ -153,7 +156,14 @@ private:
     http_request_type request_;
     http_response_type response_;
     boost::beast::http::fields const& headers_;
-    std::queue<std::shared_ptr<Message>> send_queue_;
+    std::deque<std::shared_ptr<Message>> send_queue_;
+    // Number of messages at the front of send_queue_ being written
+    std::size_t writing_ = 0;
+    // true while the next message to write is compressed on the job queue
+    bool compressing_ = false;
+    // Number of writes issued, and of messages they carried
+    std::atomic<std::uint64_t> writeCount_{0};
+    std::atomic<std::uint64_t> writeMessages_{0};
     bool gracefulClose_ = false;
     int large_sendq_ = 0;
     std::unique_ptr<LoadEvent> load_event_;
@@ -165,7 +175,7 @@ private:
     hash_map<PublicKey, NodeStore::ShardInfo> shardInfos_;
     std::mutex mutable shardInfoMutex_;
 
-    Compressed compressionEnabled_ = Compressed::Off;
+    Algorithm compression_ = Algorithm::None;
     // true if validation/proposal reduce-relay feature is enabled
     // on the peer.
     bool vpReduceRelayEnabled_ = false;
@@ -397,7 +407,7 @@ public:
     bool
     compressionEnabled() const override
     {
-        return compressionEnabled_ == Compressed::On;
+        return compression_ != Algorithm::None;
     }
 
 private:
@@ -448,6 +458,18 @@ private:
     void
     onReadMessage(error_code ec, std::size_t bytes_transferred);
 
+    // Writes the messages at the front of the send queue
+    void
+    startWrite();
+
+    // Called when the wait to gather more messages completes
+    void
+    onCork(error_code ec);
+
+    // Called when a message waiting to be written has been compressed
+    void
+    onCompressed();
+
     // Called when protocol messages bytes are sent
     void
     onWriteMessage(error_code ec, std::size_t bytes_transferred);
@@ -527,6 +549,21 @@ public:
     void
     onMessage(std::shared_ptr<protocol::TMReplayDeltaResponse> const& m);
 
+    /** Check a transaction this peer relayed, charging the peer if it is
+        bad. Called from the job queue, for a batch of transactions at once.
+        @param checkSignature false to trust the signature
+        @param stx The transaction
+        @param rules The rules of the last validated ledger
+        @param validLedgerIndex The sequence of the last validated ledger
+        @return The transaction to apply, or nullptr if it was rejected
+    */
+    std::shared_ptr<Transaction>
+    checkTransaction(
+        bool checkSignature,
+        std::shared_ptr<STTx const> const& stx,
+        Rules const& rules,
+        LedgerIndex validLedgerIndex);
+
 private:
     //--------------------------------------------------------------------------
     // lockedRecentLock is passed as a reminder to callers that recentLock_
@@ -546,12 +583,6 @@ private:
         std::uint32_t version,
         std::vector<ValidatorBlobInfo> const& blobs);
 
-    void
-    checkTransaction(
-        int flags,
-        bool checkSignature,
-        std::shared_ptr<STTx const> const& stx);
-
     void
     checkPropose(
         Job& job,
@@ -593,6 +624,7 @@ PeerImp::PeerImp(
     , stream_(*stream_ptr_)
     , strand_(socket_.get_executor())
     , timer_(waitable_timer{socket_.get_executor()})
+    , corkTimer_(waitable_timer{socket_.get_executor()})
     , remote_address_(slot->remote_endpoint())
     , overlay_(overlay)
     , inbound_(false)
@@ -608,14 +640,8 @@ PeerImp::PeerImp(
     , slot_(std::move(slot))
     , response_(std::move(response))
     , headers_(response_)
-    , compressionEnabled_(
-          peerFeatureEnabled(
-              headers_,
-              FEATURE_COMPR,
-              "lz4",
-              app_.config().COMPRESSION)
-              ? Compressed::On
-              : Compressed::Off)
+    , compression_(
+          peerCompressionAlgorithm(headers_, app_.config().COMPRESSION))
     , vpReduceRelayEnabled_(peerFeatureEnabled(
           headers_,
           FEATURE_VPRR,
@@ -629,7 +655,7 @@ PeerImp::PeerImp(
     read_buffer_.commit(boost::asio::buffer_copy(
         read_buffer_.prepare(boost::asio::buffer_size(buffers)), buffers));
     JLOG(journal_.debug()) << "compression enabled "
-                           << (compressionEnabled_ == Compressed::On)
+                           << static_cast<int>(compression_)
                            << " vp reduce-relay enabled "
                            << vpReduceRelayEnabled_ << " on " << remote_address_
                            << " " << id_;
@@ -138,8 +138,7 @@ struct MessageHeader
     std::uint16_t message_type = 0;
 
     /** Indicates which compression algorithm the payload is compressed with.
-     * Currenly only lz4 is supported. If None then the message is not
-     * compressed.
+     * Either lz4 or zstd. If None then the message is not compressed.
      */
     compression::Algorithm algorithm = compression::Algorithm::None;
 };
@@ -206,7 +205,8 @@ parseMessageHeader(
 
         hdr.algorithm = static_cast<compression::Algorithm>(*iter & 0xF0);
 
-        if (hdr.algorithm != compression::Algorithm::LZ4)
+        if (hdr.algorithm != compression::Algorithm::LZ4 &&
+            hdr.algorithm != compression::Algorithm::ZSTD)
         {
             ec = make_error_code(boost::system::errc::protocol_error);
             return std::nullopt;
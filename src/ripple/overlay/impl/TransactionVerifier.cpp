@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/app/misc/HashRouter.h>
+#include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/app/misc/Transaction.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/overlay/impl/PeerImp.h>
+#include <ripple/overlay/impl/TransactionVerifier.h>
+#include <ripple/overlay/impl/Tuning.h>
+
+namespace ripple {
+
+TransactionVerifier::TransactionVerifier(Application& app) : app_(app)
+{
+}
+
+void
+TransactionVerifier::add(Item&& item)
+{
+    ++size_;
+
+    std::unique_lock lock(mutex_);
+    pending_.push_back(std::move(item));
+
+    if (pending_.size() >= Tuning::checkTransactionBatch)
+    {
+        std::vector<Item> batch;
+        batch.swap(pending_);
+        lock.unlock();
+        return dispatch(std::move(batch));
+    }
+
+    if (flushQueued_)
+        return;
+
+    if (app_.getJobQueue().addJob(
+            jtTRANSACTION, "recvTransaction->checkTransaction", [this](Job&) {
+                flush();
+            }))
+    {
+        flushQueued_ = true;
+        return;
+    }
+
+    // The job queue is stopping, so nothing would ever check these
+    size_ -= pending_.size();
+    pending_.clear();
+}
+
+void
+TransactionVerifier::dispatch(std::vector<Item>&& batch)
+{
+    auto const count = batch.size();
+    if (!app_.getJobQueue().addJob(
+            jtTRANSACTION,
+            "recvTransaction->checkTransaction",
+            [this, batch = std::move(batch)](Job&) { check(batch); }))
+    {
+        size_ -= count;
+    }
+}
+
+void
+TransactionVerifier::flush()
+{
+    std::vector<Item> batch;
+    {
+        std::lock_guard lock(mutex_);
+        flushQueued_ = false;
+        batch.swap(pending_);
+    }
+    if (!batch.empty())
+        check(batch);
+}
+
+void
+TransactionVerifier::check(std::vector<Item> const& batch)
+{
+    auto& ledgerMaster = app_.getLedgerMaster();
+    auto const rules = ledgerMaster.getValidatedRules();
+    auto const validLedgerIndex = ledgerMaster.getValidLedgerIndex();
+
+    std::vector<std::shared_ptr<Transaction>> trusted;
+    std::vector<std::shared_ptr<Transaction>> untrusted;
+
+    // Each signature is checked on its own. ed25519-donna's batch check
+    // must not replace this: its equation is not cofactored, so it can
+    // accept signatures that a single check rejects. See verifyBatch.
+    for (auto const& item : batch)
+    {
+        auto const peer = item.peer.lock();
+        if (!peer)
+            continue;
+
+        if (auto tx = peer->checkTransaction(
+                item.checkSignature, item.stx, rules, validLedgerIndex))
+        {
+            if (item.flags & SF_TRUSTED)
+                trusted.push_back(std::move(tx));
+            else
+                untrusted.push_back(std::move(tx));
+        }
+    }
+    size_ -= batch.size();
+
+    if (!trusted.empty())
+        app_.getOPs().processTransactions(trusted, true);
+    if (!untrusted.empty())
+        app_.getOPs().processTransactions(untrusted, false);
+}
+
+}  // namespace ripple
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_TRANSACTIONVERIFIER_H_INCLUDED
+#define RIPPLE_OVERLAY_TRANSACTIONVERIFIER_H_INCLUDED
+
+#include <ripple/protocol/STTx.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+class Application;
+class PeerImp;
+
+/** Checks the transactions relayed by peers in batches.
+
+    Transactions collect while a job to check them waits in the job queue,
+    and each job checks up to Tuning::checkTransactionBatch of them. When
+    many arrive at once several jobs run together, so the signatures are
+    checked on all of the job queue's threads. The transactions that pass
+    go to NetworkOPs together.
+*/
+class TransactionVerifier
+{
+public:
+    struct Item
+    {
+        // The peer that relayed the transaction
+        std::weak_ptr<PeerImp> peer;
+        // HashRouter flags, SF_TRUSTED if a cluster peer applied it
+        int flags;
+        bool checkSignature;
+        std::shared_ptr<STTx const> stx;
+    };
+
+    explicit TransactionVerifier(Application& app);
+
+    TransactionVerifier(TransactionVerifier const&) = delete;
+    TransactionVerifier&
+    operator=(TransactionVerifier const&) = delete;
+
+    /** Queue a transaction to be checked. */
+    void
+    add(Item&& item);
+
+    /** The number of transactions queued or being checked. */
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+private:
+    // Check a full batch on its own job
+    void
+    dispatch(std::vector<Item>&& batch);
+
+    // Check whatever has collected since the job was queued
+    void
+    flush();
+
+    void
+    check(std::vector<Item> const& batch);
+
+    Application& app_;
+    std::mutex mutex_;
+    std::vector<Item> pending_;
+    // Whether a job to flush pending_ is queued
+    bool flushQueued_ = false;
+    std::atomic<std::size_t> size_{0};
+};
+
+}  // namespace ripple
+
+#endif
@@ -59,6 +59,15 @@ enum {
 /** Size of buffer used to read from the socket. */
 std::size_t constexpr readBufferBytes = 16384;
 
+/** Most bytes of queued messages gathered into one write to a peer. */
+std::size_t constexpr sendCoalesceBytes = 65536;
+
+/** Messages at least this large are compressed on the job queue. */
+std::size_t constexpr compressAsyncBytes = 16384;
+
+/** Most relayed transactions checked by one job. */
+std::size_t constexpr checkTransactionBatch = 64;
+
 }  // namespace Tuning
 
 }  // namespace ripple
@@ -31,6 +31,7 @@
 #include <optional>
 #include <ostream>
 #include <utility>
+#include <vector>
 
 namespace ripple {
 
@@ -257,6 +258,25 @@ verify(
     Slice const& sig,
     bool mustBeFullyCanonical = true) noexcept;
 
+/** A signature to check with verifyBatch.
+    The key and the data must outlive the call.
+*/
+struct SignatureCheck
+{
+    PublicKey const& publicKey;
+    Slice message;
+    Slice signature;
+    bool mustBeFullyCanonical = true;
+};
+
+/** Verify a batch of signatures on messages.
+    Each result is exactly what verify() returns for the same check, so
+    a batch may mix key types and contain bad signatures.
+    @return One result per check, in order
+*/
+[[nodiscard]] std::vector<bool>
+verifyBatch(std::vector<SignatureCheck> const& checks);
+
 /** Calculate the 160-bit node ID from a node public key. */
 NodeID
 calcNodeID(PublicKey const&);
@@ -295,6 +295,27 @@ verify(
     return false;
 }
 
+std::vector<bool>
+verifyBatch(std::vector<SignatureCheck> const& checks)
+{
+    // ed25519-donna's ed25519_sign_open_batch is not used. Its batch
+    // equation is checked without the cofactor, so a signature whose R has
+    // a small order component, which ed25519_sign_open rejects, can pass
+    // the batch by chance. Whether a signature is valid must not depend on
+    // how it was checked, or servers could disagree about a transaction.
+    std::vector<bool> results;
+    results.reserve(checks.size());
+    for (auto const& check : checks)
+    {
+        results.push_back(verify(
+            check.publicKey,
+            check.message,
+            check.signature,
+            check.mustBeFullyCanonical));
+    }
+    return results;
+}
+
 NodeID
 calcNodeID(PublicKey const& pk)
 {
@@ -120,6 +120,7 @@ JSS(acquiring);              // out: LedgerRequest
 JSS(address);                // out: PeerImp
 JSS(affected);               // out: AcceptedLedgerTx
 JSS(age);                    // out: NetworkOPs, Peers
+JSS(allocations);            // out: GetCounts
 JSS(alternatives);           // out: PathRequest, RipplePathFind
 JSS(amendment_blocked);      // out: NetworkOPs
 JSS(amendments);             // in: AccountObjects, out: NetworkOPs
@@ -135,6 +136,7 @@ JSS(auth_change_queued);     // out: AccountInfo
 JSS(available);              // out: ValidatorList
 JSS(avg_bps_recv);           // out: Peers
 JSS(avg_bps_sent);           // out: Peers
+JSS(avg_msgs_per_write);     // out: Peers
 JSS(balance);                // out: AccountLines
 JSS(balances);               // out: GatewayBalances
 JSS(base);                   // out: LogLevel
@@ -195,6 +197,7 @@ JSS(dbKBLedger);              // out: getCounts
 JSS(dbKBTotal);               // out: getCounts
 JSS(dbKBTransaction);         // out: getCounts
 JSS(debug_signing);           // in: TransactionSign
+JSS(deallocations);           // out: GetCounts
 JSS(deletion_blockers_only);  // in: AccountObjects
 JSS(delivered_amount);        // out: insertDeliveredAmount
 JSS(deposit_authorized);      // out: deposit_authorized
@@ -247,6 +250,7 @@ JSS(fee_level);             // out: AccountInfo
 JSS(fee_mult_max);          // in: TransactionSign
 JSS(fee_ref);               // out: NetworkOPs
 JSS(fetch_pack);            // out: NetworkOPs
+JSS(finalizing_shards);     // out: OverlayImpl, NodeToShardStatus
 JSS(first);                 // out: rpc/Version
 JSS(firstSequence);         // out: NodeToShardStatus
 JSS(firstShardIndex);       // out: NodeToShardStatus
@@ -281,6 +285,7 @@ JSS(inbound);               // out: PeerImp
 JSS(index);                 // in: LedgerEntry, DownloadShard
                             // out: STLedgerEntry,
                             //      LedgerEntry, TxHistory, LedgerData
+JSS(inner_node_arrays);     // out: GetCounts
 JSS(info);                  // out: ServerInfo, ConsensusInfo, FetchInfo
 JSS(internal_command);      // in: Internal
 JSS(invalid_API_version);   // out: Many, when a request has an invalid
@@ -326,6 +331,8 @@ JSS(ledger_index_min);            // in, out: AccountTx*
 JSS(ledger_max);                  // in, out: AccountTx*
 JSS(ledger_min);                  // in, out: AccountTx*
 JSS(ledger_time);                 // out: NetworkOPs
+JSS(ledgers_per_second);          // out: OverlayImpl, NodeToShardStatus
+JSS(ledgers_verified);            // out: OverlayImpl, NodeToShardStatus
 JSS(levels);                      // LogLevels
 JSS(limit);                       // in/out: AccountTx*, AccountOffers,
                                   //         AccountLines, AccountObjects
@@ -361,6 +368,7 @@ JSS(master_key);                  // out: WalletPropose, NetworkOPs,
 JSS(master_seed);                 // out: WalletPropose
 JSS(master_seed_hex);             // out: WalletPropose
 JSS(master_signature);            // out: pubManifest
+JSS(max);                         // out: GetCounts
 JSS(max_ledger);                  // in/out: LedgerCleaner
 JSS(max_queue_size);              // out: TxQ
 JSS(max_spend_drops);             // out: AccountInfo
@@ -389,19 +397,30 @@ JSS(no_ripple);                  // out: AccountLines
 JSS(no_ripple_peer);             // out: AccountLines
 JSS(node);                       // out: LedgerEntry
 JSS(node_binary);                // out: LedgerEntry
+JSS(node_read_batch_objects);    // out: GetCounts
+JSS(node_read_batches);          // out: GetCounts
+JSS(node_read_batches_latency_us);  // out: GetCounts
 JSS(node_read_bytes);            // out: GetCounts
 JSS(node_read_errors);           // out: GetCounts
+JSS(node_read_queue);            // out: GetCounts
+JSS(node_read_queue_max);        // out: GetCounts
+JSS(node_read_threads);          // out: GetCounts
 JSS(node_read_retries);          // out: GetCounts
 JSS(node_reads_hit);             // out: GetCounts
 JSS(node_reads_total);           // out: GetCounts
 JSS(node_reads_duration_us);     // out: GetCounts
+JSS(node_reads_async_latency_us);  // out: GetCounts
+JSS(node_reads_sync_latency_us);   // out: GetCounts
 JSS(node_size);                  // out: server_info
 JSS(nodestore);                  // out: GetCounts
 JSS(node_writes);                // out: GetCounts
 JSS(node_written_bytes);         // out: GetCounts
 JSS(node_writes_duration_us);    // out: GetCounts
+JSS(node_writes_latency_us);     // out: GetCounts
+JSS(node_write_batches_latency_us);  // out: GetCounts
 JSS(node_write_retries);         // out: GetCounts
 JSS(node_writes_delayed);        // out::GetCounts
+JSS(nodes_per_second);           // out: InboundLedger
 JSS(obligations);                // out: GatewayBalances
 JSS(offer);                      // in: LedgerEntry
 JSS(offers);                     // out: NetworkOPs, AccountOffers, Subscribe
@@ -413,6 +432,10 @@ JSS(open_ledger_fee);            // out: TxQ
 JSS(open_ledger_level);          // out: TxQ
 JSS(owner);                      // in: LedgerEntry, out: NetworkOPs
 JSS(owner_funds);                // in/out: Ledger, NetworkOPs, AcceptedLedgerTx
+JSS(p50);                        // out: GetCounts
+JSS(p90);                        // out: GetCounts
+JSS(p99);                        // out: GetCounts
+JSS(p999);                       // out: GetCounts
 JSS(params);                     // RPC
 JSS(parent_close_time);          // out: LedgerToJson
 JSS(parent_hash);                // out: LedgerToJson
@@ -430,6 +453,7 @@ JSS(peers);                      // out: InboundLedger, handlers/Peers, Overlay
 JSS(peer_disconnects);           // Severed peer connection counter.
 JSS(peer_disconnects_resources);  // Severed peer connections because of
                                   // excess resource consumption.
+JSS(percent_progress);            // out: OverlayImpl, NodeToShardStatus
 JSS(port);                        // in: Connect
 JSS(previous);                    // out: Reservations
 JSS(previous_ledger);             // out: LedgerPropose
@@ -463,6 +487,7 @@ JSS(refresh_interval_min);  // out: ValidatorSites
 JSS(regular_seed);          // in/out: LedgerEntry
 JSS(remaining);             // out: ValidatorList
 JSS(remote);                // out: Logic.h
+JSS(reserved_bytes);        // out: GetCounts
 JSS(request);               // RPC
 JSS(requested);             // out: Manifest
 JSS(reservations);          // out: Reservations
@@ -475,6 +500,9 @@ JSS(result);                // RPC
 JSS(ripple_lines);          // out: NetworkOPs
 JSS(ripple_state);          // in: LedgerEntr
 JSS(ripplerpc);             // ripple RPC version
+JSS(rocksdb_compaction_pending);   // out: GetCounts
+JSS(rocksdb_running_compactions);  // out: GetCounts
+JSS(rocksdb_write_amplification);  // out: GetCounts
 JSS(role);                  // out: Ping.cpp
 JSS(rpc);
 JSS(rt_accounts);  // in: Subscribe, Unsubscribe
@@ -539,6 +567,11 @@ JSS(threshold);           // in: Blacklist
 JSS(ticket);              // in: AccountObjects
 JSS(ticket_count);        // out: AccountInfo
 JSS(ticket_seq);          // in: LedgerEntry
+JSS(tiered_cache_reads_hit);      // out: GetCounts
+JSS(tiered_cache_reads_total);    // out: GetCounts
+JSS(tiered_cache_rotations);      // out: GetCounts
+JSS(tiered_cache_writes);         // out: GetCounts
+JSS(tiered_cache_written_bytes);  // out: GetCounts
 JSS(time);
 JSS(timeouts);                // out: InboundLedger
 JSS(track);                   // out: PeerImp
@@ -547,6 +580,8 @@ JSS(total);                   // out: counters
 JSS(totalCoins);              // out: LedgerToJson
 JSS(total_bytes_recv);        // out: Peers
 JSS(total_bytes_sent);        // out: Peers
+JSS(total_msgs_sent);         // out: Peers
+JSS(total_writes);            // out: Peers
 JSS(total_coins);             // out: LedgerToJson
 JSS(transTreeHash);           // out: ledger/Ledger.cpp
 JSS(transaction);             // in: Tx
@@ -32,6 +32,7 @@
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/shamap/SHAMapInnerNode.h>
 #include <ripple/shamap/ShardFamily.h>
 
 namespace ripple {
@@ -117,6 +118,7 @@ getCountsJson(Application& app, int minObjectCount)
         app.getNodeFamily().getTreeNodeCache(0)->getCacheSize();
     ret[jss::treenode_track_size] =
         app.getNodeFamily().getTreeNodeCache(0)->getTrackSize();
+    SHAMapInnerNode::getCountsJson(ret);
 
     std::string uptime;
     auto s = UptimeClock::now();
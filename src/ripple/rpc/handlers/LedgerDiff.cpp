@@ -1,5 +1,6 @@
 #include <ripple/rpc/GRPCHandlers.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
+#include <ripple/rpc/impl/Tuning.h>
 
 namespace ripple {
 std::pair<org::xrpl::rpc::v1::GetLedgerDiffResponse, grpc::Status>
@@ -51,7 +52,10 @@ doLedgerDiffGrpc(
     int maxDifferences = std::numeric_limits<int>::max();
 
     bool res = baseLedger->stateMap().compare(
-        desiredLedger->stateMap(), differences, maxDifferences);
+        desiredLedger->stateMap(),
+        differences,
+        maxDifferences,
+        RPC::Tuning::ledgerDiffThreads);
     if (!res)
     {
         grpc::Status errorStatus{
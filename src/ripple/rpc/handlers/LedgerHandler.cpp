@@ -29,6 +29,7 @@
 #include <ripple/rpc/handlers/LedgerHandler.h>
 #include <ripple/rpc/impl/GRPCHelpers.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
+#include <ripple/rpc/impl/Tuning.h>
 
 namespace ripple {
 namespace RPC {
@@ -175,7 +176,10 @@ doLedgerGrpc(RPC::GRPCContext<org::xrpl::rpc::v1::GetLedgerRequest>& context)
         int maxDifferences = std::numeric_limits<int>::max();
 
         bool res = base->stateMap().compare(
-            desired->stateMap(), differences, maxDifferences);
+            desired->stateMap(),
+            differences,
+            maxDifferences,
+            RPC::Tuning::ledgerDiffThreads);
         if (!res)
         {
             grpc::Status errorStatus{
@@ -33,7 +33,13 @@ doNodeToShardStatus(RPC::JsonContext& context)
     Json::Value ret(Json::objectValue);
 
     if (auto const shardStore = context.app.getShardStore())
+    {
         ret[jss::info] = shardStore->getDatabaseImportStatus();
+        if (auto finalizing{shardStore->getFinalizeStatus()}; finalizing)
+        {
+            ret[jss::finalizing_shards] = std::move(finalizing);
+        }
+    }
     else
         ret = RPC::make_error(rpcINTERNAL, "No shard store");
 
@@ -91,8 +91,7 @@ doTxPostgres(RPC::Context& context, TxArgs const& args)
                 locator.getNodestoreHash(), locator.getLedgerSequence()))
         {
             auto node = SHAMapTreeNode::makeFromPrefix(
-                makeSlice(obj->getData()),
-                SHAMapHash{locator.getNodestoreHash()});
+                obj->getData(), SHAMapHash{locator.getNodestoreHash()});
             if (!node)
             {
                 assert(false);
@@ -71,6 +71,9 @@ inline int constexpr pageLength(bool isBinary)
     return isBinary ? binaryPageLength : jsonPageLength;
 }
 
+/** Number of threads used to diff two state maps for one request. */
+static std::size_t constexpr ledgerDiffThreads = 4;
+
 /** Maximum number of source currencies allowed in a path find request. */
 static int constexpr max_src_cur = 18;
 
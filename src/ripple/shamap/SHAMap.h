@@ -119,6 +119,9 @@ public:
     /** The depth of the hash map: data is only present in the leaves */
     static inline constexpr unsigned int leafDepth = 64;
 
+    /** The number of sibling subtrees read ahead of a full traversal */
+    static inline constexpr int readAheadBranches = 8;
+
     using DeltaItem = std::pair<
         std::shared_ptr<SHAMapItem const>,
         std::shared_ptr<SHAMapItem const>>;
@@ -217,9 +220,15 @@ public:
 
          @param function called with every node visited.
          If function returns false, visitNodes exits.
+         @param threads If greater than one, the subtrees below the root
+                        are visited on up to this many threads at once.
+                        `function` is then called concurrently and the
+                        order of the visits is unspecified.
     */
     void
-    visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const;
+    visitNodes(
+        std::function<bool(SHAMapTreeNode&)> const& function,
+        std::size_t threads = 1) const;
 
     /**  Visit every node in this SHAMap that
          is not present in the specified SHAMap
@@ -251,10 +260,15 @@ public:
 
         @param maxNodes The maximum number of found nodes to return
         @param filter The filter to use when retrieving nodes
+        @param threads If greater than one, the subtrees below the root
+                       are traversed on up to this many threads at once.
         @param return The nodes known to be missing
     */
     std::vector<std::pair<SHAMapNodeID, uint256>>
-    getMissingNodes(int maxNodes, SHAMapSyncFilter* filter);
+    getMissingNodes(
+        int maxNodes,
+        SHAMapSyncFilter* filter,
+        std::size_t threads = 1);
 
     bool
     getNodeFat(
@@ -315,16 +329,29 @@ public:
 
     // caution: otherMap must be accessed only by this function
     // return value: true=successfully completed, false=too different
+    // If threads is greater than one, differing subtrees are compared
+    // concurrently; the differences and return value are unaffected.
     bool
-    compare(SHAMap const& otherMap, Delta& differences, int maxCount) const;
+    compare(
+        SHAMap const& otherMap,
+        Delta& differences,
+        int maxCount,
+        std::size_t threads = 1) const;
 
     /** Convert any modified nodes to shared. */
     int
     unshare();
 
-    /** Flush modified nodes to the nodestore and convert them to shared. */
+    /** Flush modified nodes to the nodestore and convert them to shared.
+
+        @param t The type of node object to store.
+        @param threads If greater than one, the modified subtrees below the
+                       root are flushed on up to this many threads at once.
+                       The result is identical either way.
+        @return The number of nodes flushed.
+    */
     int
-    flushDirty(NodeObjectType t);
+    flushDirty(NodeObjectType t, std::size_t threads = 1);
 
     void
     walkMap(std::vector<SHAMapMissingNode>& missingNodes, int maxMissing) const;
@@ -396,6 +423,16 @@ private:
     std::shared_ptr<SHAMapTreeNode>
     writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const;
 
+    /** Start background reads of the children of `node` that a traversal
+        currently at `branch` will visit next, so they are in the tree node
+        cache by the time it gets there. If `entered` is true, the traversal
+        just reached `node` and every child in the window is read; otherwise
+        the traversal moved over by one child and only the one that newly
+        entered the window is read.
+    */
+    void
+    readAhead(SHAMapInnerNode* node, int branch, bool entered) const;
+
     SHAMapLeafNode*
     firstBelow(
         std::shared_ptr<SHAMapTreeNode>,
@@ -457,8 +494,40 @@ private:
         bool isFirstMap,
         Delta& differences,
         int& maxCount) const;
+    bool
+    compareNodes(
+        SHAMapTreeNode* ourNode,
+        SHAMapTreeNode* otherNode,
+        SHAMap const& otherMap,
+        Delta& differences,
+        int& maxCount) const;
+    bool
+    compareParallel(
+        SHAMap const& otherMap,
+        Delta& differences,
+        int maxCount,
+        std::size_t threads) const;
     int
-    walkSubTree(bool doWrite, NodeObjectType t);
+    walkSubTree(bool doWrite, NodeObjectType t, std::size_t threads = 1);
+
+    /** Visit every node below `node`, depth first.
+
+        @return false if `function` stopped the visit.
+    */
+    bool
+    visitSubTree(
+        std::shared_ptr<SHAMapInnerNode> node,
+        std::function<bool(SHAMapTreeNode&)> const& function) const;
+
+    /** Flush every modified node below and including `node`, which must
+        already be owned by this map. On return `node` is the flushed,
+        shared version.
+    */
+    int
+    flushInnerNode(
+        std::shared_ptr<SHAMapInnerNode>& node,
+        bool doWrite,
+        NodeObjectType t);
 
     // Structure to track information about call to
     // getMissingNodes while it's in progress
@@ -531,6 +600,10 @@ private:
     gmn_ProcessNodes(MissingNodes&, MissingNodes::StackEntry& node);
     void
     gmn_ProcessDeferredReads(MissingNodes&);
+    void
+    gmn_Traverse(MissingNodes&, MissingNodes::StackEntry pos);
+    void
+    gmn_ProcessParallel(MissingNodes&, std::size_t threads);
 
     // fetch from DB helper function
     std::shared_ptr<SHAMapTreeNode>
@@ -22,11 +22,13 @@
 
 #include <ripple/basics/TaggedCache.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
 #include <ripple/shamap/SHAMapItem.h>
 #include <ripple/shamap/SHAMapNodeID.h>
 #include <ripple/shamap/SHAMapTreeNode.h>
 #include <ripple/shamap/impl/TaggedPointer.h>
 
+#include <atomic>
 #include <bitset>
 #include <cstdint>
 #include <memory>
@@ -53,7 +55,11 @@ private:
     std::uint32_t fullBelowGen_ = 0;
     std::uint16_t isBranch_ = 0;
 
-    static std::mutex childLock;
+    /** A spinlock bit for each child pointer. It fits in the padding after
+        `isBranch_`, so readers of different nodes (or different children
+        of one node) never contend.
+     */
+    mutable std::atomic<std::uint16_t> lock_{0};
 
     /** Convert arrays stored in `hashesAndChildren_` so they can store the
         requested number of children.
@@ -189,6 +195,10 @@ public:
 
     static std::shared_ptr<SHAMapTreeNode>
     makeCompressedInner(Slice data);
+
+    /** Add the allocation counts for each size of child array to `obj`. */
+    static void
+    getCountsJson(Json::Value& obj);
 };
 
 inline bool
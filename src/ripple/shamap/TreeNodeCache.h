@@ -24,7 +24,15 @@
 
 namespace ripple {
 
-using TreeNodeCache = TaggedCache<uint256, SHAMapTreeNode>;
+// The tree node cache is shared by every SHAMap in the process, so its key
+// space is striped across independently locked partitions.
+using TreeNodeCache = TaggedCache<
+    uint256,
+    SHAMapTreeNode,
+    hardened_hash<>,
+    std::equal_to<uint256>,
+    std::recursive_mutex,
+    32>;
 
 }  // namespace ripple
 
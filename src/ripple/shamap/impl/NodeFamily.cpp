@@ -21,6 +21,7 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/main/Tuning.h>
 #include <ripple/shamap/NodeFamily.h>
+#include <thread>
 
 namespace ripple {
 
@@ -48,7 +49,11 @@ void
 NodeFamily::sweep()
 {
     fbCache_->sweep();
-    tnCache_->sweep();
+
+    // Sweep in slices so that threads using the cache are never
+    // locked out of a partition for the duration of a full pass
+    while (!tnCache_->sweepSlice(treeCacheSweepSlice))
+        std::this_thread::yield();
 }
 
 void
@@ -25,6 +25,12 @@
 #include <ripple/shamap/SHAMapTxLeafNode.h>
 #include <ripple/shamap/SHAMapTxPlusMetaLeafNode.h>
 
+#include <array>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 namespace ripple {
 
 [[nodiscard]] std::shared_ptr<SHAMapLeafNode>
@@ -186,8 +192,7 @@ SHAMap::finishFetch(
     std::shared_ptr<SHAMapTreeNode> node;
     try
     {
-        node =
-            SHAMapTreeNode::makeFromPrefix(makeSlice(object->getData()), hash);
+        node = SHAMapTreeNode::makeFromPrefix(object->getData(), hash);
         if (node)
             canonicalize(hash, node);
         return node;
@@ -436,6 +441,54 @@ SHAMap::unshareNode(std::shared_ptr<Node> node, SHAMapNodeID const& nodeID)
     return node;
 }
 
+void
+SHAMap::readAhead(SHAMapInnerNode* node, int branch, bool entered) const
+{
+    if (!backed_)
+        return;
+
+    int ahead = 0;
+    for (int i = branch + 1; i < branchFactor && ahead < readAheadBranches;
+         ++i)
+    {
+        if (node->isEmptyBranch(i))
+            continue;
+
+        if (++ahead < readAheadBranches && !entered)
+            continue;
+
+        if (node->getChildPointer(i))
+            continue;
+
+        auto const& hash = node->getChildHash(i);
+        if (cacheLookup(hash))
+            continue;
+
+        // Only the tree node cache is touched when the read completes,
+        // so neither this map nor the node has to outlive it.
+        f_.db().asyncFetch(
+            hash.as_uint256(),
+            ledgerSeq_,
+            [cache = f_.getTreeNodeCache(ledgerSeq_),
+             hash](std::shared_ptr<NodeObject> const& object) {
+                if (!object)
+                    return;
+
+                try
+                {
+                    if (auto child = SHAMapTreeNode::makeFromPrefix(
+                            object->getData(), hash))
+                        cache->canonicalize_replace_client(
+                            hash.as_uint256(), child);
+                }
+                catch (std::exception const&)
+                {
+                    // The traversal's own fetch will report the bad node
+                }
+            });
+    }
+}
+
 SHAMapLeafNode*
 SHAMap::firstBelow(
     std::shared_ptr<SHAMapTreeNode> node,
@@ -458,6 +511,7 @@ SHAMap::firstBelow(
     {
         if (!inner->isEmptyBranch(i))
         {
+            readAhead(inner.get(), i, true);
             node = descendThrow(inner, i);
             assert(!stack.empty());
             if (node->isLeaf())
@@ -543,6 +597,7 @@ SHAMap::peekNextItem(uint256 const& id, SharedPtrNodeStack& stack) const
         {
             if (!inner->isEmptyBranch(i))
             {
+                readAhead(inner.get(), i, false);
                 node = descendThrow(inner, i);
                 auto leaf = firstBelow(node, stack, i);
                 if (!leaf)
@@ -606,6 +661,7 @@ SHAMap::upper_bound(uint256 const& id) const
             {
                 if (!inner->isEmptyBranch(branch))
                 {
+                    readAhead(inner.get(), branch, true);
                     node = descendThrow(inner, branch);
                     auto leaf = firstBelow(node, stack, branch);
                     if (!leaf)
@@ -920,14 +976,14 @@ SHAMap::unshare()
 }
 
 int
-SHAMap::flushDirty(NodeObjectType t)
+SHAMap::flushDirty(NodeObjectType t, std::size_t threads)
 {
     // We only write back if this map is backed.
-    return walkSubTree(backed_, t);
+    return walkSubTree(backed_, t, threads);
 }
 
 int
-SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
+SHAMap::walkSubTree(bool doWrite, NodeObjectType t, std::size_t threads)
 {
     assert(!doWrite || backed_);
 
@@ -956,13 +1012,100 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
         return 1;
     }
 
+    node = preFlushNode(std::move(node));
+
+    if (threads > 1)
+    {
+        // The modified inner nodes directly below the root head disjoint
+        // subtrees, all owned by this map, so they can be flushed in
+        // parallel. Once they are shared again the serial pass below
+        // skips them and only has the root and its leaves left to do.
+        std::array<std::shared_ptr<SHAMapInnerNode>, branchFactor> subtrees;
+        std::size_t count = 0;
+        for (int branch = 0; branch < branchFactor; ++branch)
+        {
+            if (node->isEmptyBranch(branch))
+                continue;
+
+            auto child = node->getChild(branch);
+            if (child && child->cowid() != 0 && child->isInner())
+            {
+                subtrees[branch] = preFlushNode(
+                    std::static_pointer_cast<SHAMapInnerNode>(
+                        std::move(child)));
+                ++count;
+            }
+        }
+
+        std::atomic<int> next{0};
+        std::atomic<int> subtreeFlushed{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        auto work = [&]() {
+            try
+            {
+                for (int branch; (branch = next++) < branchFactor;)
+                {
+                    if (subtrees[branch])
+                        subtreeFlushed +=
+                            flushInnerNode(subtrees[branch], doWrite, t);
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        if (count > 1)
+        {
+            workers.reserve(std::min(threads, count) - 1);
+            for (std::size_t i = 1; i < std::min(threads, count); ++i)
+                workers.emplace_back(work);
+        }
+        work();
+        for (auto& w : workers)
+            w.join();
+
+        if (error)
+            std::rethrow_exception(error);
+
+        for (int branch = 0; branch < branchFactor; ++branch)
+        {
+            if (subtrees[branch])
+                node->shareChild(branch, subtrees[branch]);
+        }
+
+        flushed += subtreeFlushed;
+    }
+
+    flushed += flushInnerNode(node, doWrite, t);
+
+    // Last inner node is the new root_
+    root_ = std::move(node);
+
+    return flushed;
+}
+
+int
+SHAMap::flushInnerNode(
+    std::shared_ptr<SHAMapInnerNode>& node,
+    bool doWrite,
+    NodeObjectType t)
+{
+    assert(node->cowid() == cowid_);
+
+    int flushed = 0;
+
     // Stack of {parent,index,child} pointers representing
     // inner nodes we are in the process of flushing
     using StackEntry = std::pair<std::shared_ptr<SHAMapInnerNode>, int>;
     std::stack<StackEntry, std::vector<StackEntry>> stack;
 
-    node = preFlushNode(std::move(node));
-
     int pos = 0;
 
     // We can't flush an inner node until we flush its children
@@ -1045,9 +1188,6 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
         ++pos;
     }
 
-    // Last inner node is the new root_
-    root_ = std::move(node);
-
     return flushed;
 }
 
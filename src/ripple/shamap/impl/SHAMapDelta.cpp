@@ -20,6 +20,11 @@
 #include <ripple/basics/contract.h>
 #include <ripple/shamap/SHAMap.h>
 
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
+
 namespace ripple {
 
 // This code is used to compare another node's transaction tree
@@ -121,7 +126,11 @@ SHAMap::walkBranch(
 }
 
 bool
-SHAMap::compare(SHAMap const& otherMap, Delta& differences, int maxCount) const
+SHAMap::compare(
+    SHAMap const& otherMap,
+    Delta& differences,
+    int maxCount,
+    std::size_t threads) const
 {
     // compare two hash trees, add up to maxCount differences to the difference
     // table return value: true=complete table of differences given, false=too
@@ -133,11 +142,26 @@ SHAMap::compare(SHAMap const& otherMap, Delta& differences, int maxCount) const
     if (getHash() == otherMap.getHash())
         return true;
 
+    if (threads > 1 && root_->isInner() && otherMap.root_->isInner())
+        return compareParallel(otherMap, differences, maxCount, threads);
+
+    return compareNodes(
+        root_.get(), otherMap.root_.get(), otherMap, differences, maxCount);
+}
+
+bool
+SHAMap::compareNodes(
+    SHAMapTreeNode* ourNode,
+    SHAMapTreeNode* otherNode,
+    SHAMap const& otherMap,
+    Delta& differences,
+    int& maxCount) const
+{
     using StackEntry = std::pair<SHAMapTreeNode*, SHAMapTreeNode*>;
     std::stack<StackEntry, std::vector<StackEntry>>
         nodeStack;  // track nodes we've pushed
 
-    nodeStack.push({root_.get(), otherMap.root_.get()});
+    nodeStack.push({ourNode, otherNode});
     while (!nodeStack.empty())
     {
         auto [ourNode, otherNode] = nodeStack.top();
@@ -244,6 +268,151 @@ SHAMap::compare(SHAMap const& otherMap, Delta& differences, int maxCount) const
     return true;
 }
 
+// The parallel comparison splits the work along the first levels of the
+// trees, in the exact order the serial walk above would visit it. Each piece
+// is compared independently, then the results are merged in that order.
+// The serial walk can stop early, by reaching maxCount or by throwing, so
+// the piece where that would happen is compared again, serially, against
+// the merged results. That reproduces exactly where the walk stops.
+bool
+SHAMap::compareParallel(
+    SHAMap const& otherMap,
+    Delta& differences,
+    int maxCount,
+    std::size_t threads) const
+{
+    // The number of levels to split the trees along
+    static constexpr int splitDepth = 2;
+
+    struct Work
+    {
+        // If only one of these is set, the branch is missing in the other map
+        SHAMapTreeNode* ours = nullptr;
+        SHAMapTreeNode* other = nullptr;
+
+        // The serial walk would throw this before reaching the branch
+        std::exception_ptr error;
+
+        Delta differences;
+        int remaining = 0;
+        bool complete = false;
+        std::exception_ptr thrown;
+    };
+
+    std::vector<Work> work;
+    bool stopped = false;
+
+    auto const compareWork = [&](Work& w, Delta& d, int& count) {
+        if (w.ours && w.other)
+            return compareNodes(w.ours, w.other, otherMap, d, count);
+        if (w.ours)
+            return walkBranch(w.ours, {}, true, d, count);
+        return otherMap.walkBranch(w.other, {}, false, d, count);
+    };
+
+    std::function<void(SHAMapInnerNode*, SHAMapInnerNode*, int)> split =
+        [&](SHAMapInnerNode* ours, SHAMapInnerNode* other, int depth) {
+            std::vector<std::pair<SHAMapTreeNode*, SHAMapTreeNode*>> pairs;
+            for (int i = 0; i < branchFactor; ++i)
+            {
+                if (ours->getChildHash(i) == other->getChildHash(i))
+                    continue;
+
+                try
+                {
+                    if (other->isEmptyBranch(i))
+                        work.push_back({descendThrow(ours, i), nullptr});
+                    else if (ours->isEmptyBranch(i))
+                        work.push_back(
+                            {nullptr, otherMap.descendThrow(other, i)});
+                    else
+                        pairs.emplace_back(
+                            descendThrow(ours, i),
+                            otherMap.descendThrow(other, i));
+                }
+                catch (...)
+                {
+                    work.push_back({});
+                    work.back().error = std::current_exception();
+                    stopped = true;
+                    return;
+                }
+            }
+
+            // The serial walk uses a stack, so it finishes the last
+            // differing branch before starting the one before it.
+            for (auto it = pairs.rbegin(); it != pairs.rend() && !stopped; ++it)
+            {
+                auto [ourNode, otherNode] = *it;
+                if (depth > 1 && ourNode->isInner() && otherNode->isInner())
+                    split(
+                        static_cast<SHAMapInnerNode*>(ourNode),
+                        static_cast<SHAMapInnerNode*>(otherNode),
+                        depth - 1);
+                else
+                    work.push_back({ourNode, otherNode});
+            }
+        };
+
+    split(
+        static_cast<SHAMapInnerNode*>(root_.get()),
+        static_cast<SHAMapInnerNode*>(otherMap.root_.get()),
+        splitDepth);
+
+    int const limit = maxCount;
+    std::atomic<std::size_t> next{0};
+    auto const worker = [&]() {
+        for (std::size_t i; (i = next++) < work.size();)
+        {
+            auto& w = work[i];
+            if (w.error)
+                continue;
+
+            w.remaining = limit;
+            try
+            {
+                w.complete = compareWork(w, w.differences, w.remaining);
+            }
+            catch (...)
+            {
+                w.thrown = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    if (work.size() > 1)
+    {
+        auto const n = std::min(threads, work.size());
+        workers.reserve(n - 1);
+        for (std::size_t i = 1; i < n; ++i)
+            workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : workers)
+        t.join();
+
+    for (auto& w : work)
+    {
+        if (w.error)
+            std::rethrow_exception(w.error);
+
+        int const used = limit - w.remaining;
+        if (!w.complete || w.thrown || used >= maxCount)
+        {
+            // The serial walk stops inside this branch
+            if (!compareWork(w, differences, maxCount))
+                return false;
+            continue;
+        }
+
+        differences.insert(w.differences.begin(), w.differences.end());
+        maxCount -= used;
+    }
+
+    return true;
+}
+
 void
 SHAMap::walkMap(std::vector<SHAMapMissingNode>& missingNodes, int maxMissing)
     const
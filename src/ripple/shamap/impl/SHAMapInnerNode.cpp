@@ -24,6 +24,7 @@
 #include <ripple/basics/Slice.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/safe_cast.h>
+#include <ripple/basics/spinlock.h>
 #include <ripple/beast/core/LexicalCast.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/digest.h>
@@ -40,8 +41,6 @@
 
 namespace ripple {
 
-std::mutex SHAMapInnerNode::childLock;
-
 SHAMapInnerNode::SHAMapInnerNode(
     std::uint32_t cowid,
     std::uint8_t numAllocatedChildren)
@@ -51,6 +50,12 @@ SHAMapInnerNode::SHAMapInnerNode(
 
 SHAMapInnerNode::~SHAMapInnerNode() = default;
 
+void
+SHAMapInnerNode::getCountsJson(Json::Value& obj)
+{
+    TaggedPointer::getCountsJson(obj);
+}
+
 template <class F>
 void
 SHAMapInnerNode::iterChildren(F&& f) const
@@ -108,7 +113,9 @@ SHAMapInnerNode::clone(std::uint32_t cowid) const
             cloneHashes[branchNum] = thisHashes[indexNum];
         });
     }
-    std::lock_guard lock(childLock);
+    spinlock sl(lock_);
+    std::lock_guard lock(sl);
+
     if (thisIsSparse)
     {
         int cloneChildIndex = 0;
@@ -137,12 +144,10 @@ SHAMapInnerNode::makeFullInner(
 
     auto ret = std::make_shared<SHAMapInnerNode>(0, branchFactor);
 
-    Serializer s(data.data(), data.size());
-
     auto retHashes = ret->hashesAndChildren_.getHashes();
     for (int i = 0; i < branchFactor; ++i)
     {
-        s.getBitString(retHashes[i].as_uint256(), i * 32);
+        retHashes[i].as_uint256() = uint256::fromVoid(data.data() + i * 32);
 
         if (retHashes[i].isNonZero())
             ret->isBranch_ |= (1 << i);
@@ -160,24 +165,19 @@ SHAMapInnerNode::makeFullInner(
 std::shared_ptr<SHAMapTreeNode>
 SHAMapInnerNode::makeCompressedInner(Slice data)
 {
-    Serializer s(data.data(), data.size());
-
-    int len = s.getLength();
+    int len = data.size();
 
     auto ret = std::make_shared<SHAMapInnerNode>(0, branchFactor);
 
     auto retHashes = ret->hashesAndChildren_.getHashes();
     for (int i = 0; i < (len / 33); ++i)
     {
-        int pos;
+        int const pos = data[32 + (i * 33)];
 
-        if (!s.get8(pos, 32 + (i * 33)))
-            Throw<std::runtime_error>("short CI node");
-
-        if ((pos < 0) || (pos >= branchFactor))
+        if (pos >= branchFactor)
             Throw<std::runtime_error>("invalid CI node");
 
-        s.getBitString(retHashes[pos].as_uint256(), i * 33);
+        retHashes[pos].as_uint256() = uint256::fromVoid(data.data() + i * 33);
 
         if (retHashes[pos].isNonZero())
             ret->isBranch_ |= (1 << pos);
@@ -335,7 +335,8 @@ SHAMapInnerNode::getChildPointer(int branch)
     assert(branch >= 0 && branch < branchFactor);
     assert(!isEmptyBranch(branch));
 
-    std::lock_guard lock(childLock);
+    packed_spinlock sl(lock_, branch);
+    std::lock_guard lock(sl);
     return hashesAndChildren_.getChildren()[*getChildIndex(branch)].get();
 }
 
@@ -345,7 +346,8 @@ SHAMapInnerNode::getChild(int branch)
     assert(branch >= 0 && branch < branchFactor);
     assert(!isEmptyBranch(branch));
 
-    std::lock_guard lock(childLock);
+    packed_spinlock sl(lock_, branch);
+    std::lock_guard lock(sl);
     return hashesAndChildren_.getChildren()[*getChildIndex(branch)];
 }
 
@@ -371,7 +373,9 @@ SHAMapInnerNode::canonicalizeChild(
     auto [_, hashes, children] = hashesAndChildren_.getHashesAndChildren();
     assert(node->getHash() == hashes[childIndex]);
 
-    std::lock_guard lock(childLock);
+    packed_spinlock sl(lock_, branch);
+    std::lock_guard lock(sl);
+
     if (children[childIndex])
     {
         // There is already a node hooked up, return it
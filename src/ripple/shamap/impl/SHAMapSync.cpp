@@ -21,6 +21,12 @@
 #include <ripple/shamap/SHAMap.h>
 #include <ripple/shamap/SHAMapSyncFilter.h>
 
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace ripple {
 
 void
@@ -36,7 +42,9 @@ SHAMap::visitLeaves(
 }
 
 void
-SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
+SHAMap::visitNodes(
+    std::function<bool(SHAMapTreeNode&)> const& function,
+    std::size_t threads) const
 {
     if (!root_)
         return;
@@ -46,11 +54,95 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
     if (!root_->isInner())
         return;
 
+    auto root = std::static_pointer_cast<SHAMapInnerNode>(root_);
+
+    if (threads <= 1)
+    {
+        visitSubTree(std::move(root), function);
+        return;
+    }
+
+    // The children of the root head disjoint subtrees, which are
+    // visited in parallel once the children themselves are visited.
+    std::vector<std::shared_ptr<SHAMapInnerNode>> subtrees;
+    bool entered = true;
+    for (int branch = 0; branch < branchFactor; ++branch)
+    {
+        if (root->isEmptyBranch(branch))
+            continue;
+
+        readAhead(root.get(), branch, entered);
+        entered = false;
+
+        auto child = descendNoStore(root, branch);
+        if (!function(*child))
+            return;
+        if (child->isInner())
+            subtrees.push_back(
+                std::static_pointer_cast<SHAMapInnerNode>(std::move(child)));
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> stop{false};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    // Once any call returns false, every thread stops
+    std::function<bool(SHAMapTreeNode&)> const visit =
+        [&](SHAMapTreeNode& node) {
+            if (stop)
+                return false;
+            if (!function(node))
+            {
+                stop = true;
+                return false;
+            }
+            return true;
+        };
+
+    auto work = [&]() {
+        try
+        {
+            for (std::size_t i; !stop && (i = next++) < subtrees.size();)
+                visitSubTree(subtrees[i], visit);
+        }
+        catch (...)
+        {
+            stop = true;
+            std::lock_guard lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    auto const count = std::min(threads, subtrees.size());
+    if (count > 1)
+    {
+        workers.reserve(count - 1);
+        for (std::size_t i = 1; i < count; ++i)
+            workers.emplace_back(work);
+    }
+
+    work();
+
+    for (auto& worker : workers)
+        worker.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+bool
+SHAMap::visitSubTree(
+    std::shared_ptr<SHAMapInnerNode> node,
+    std::function<bool(SHAMapTreeNode&)> const& function) const
+{
     using StackEntry = std::pair<int, std::shared_ptr<SHAMapInnerNode>>;
     std::stack<StackEntry, std::vector<StackEntry>> stack;
 
-    auto node = std::static_pointer_cast<SHAMapInnerNode>(root_);
     int pos = 0;
+    bool entered = true;
 
     while (1)
     {
@@ -58,10 +150,13 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
         {
             if (!node->isEmptyBranch(pos))
             {
+                readAhead(node.get(), pos, entered);
+                entered = false;
+
                 std::shared_ptr<SHAMapTreeNode> child =
                     descendNoStore(node, pos);
                 if (!function(*child))
-                    return;
+                    return false;
 
                 if (child->isLeaf())
                     ++pos;
@@ -80,6 +175,7 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
                     // descend to the child's first position
                     node = std::static_pointer_cast<SHAMapInnerNode>(child);
                     pos = 0;
+                    entered = true;
                 }
             }
             else
@@ -94,6 +190,8 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
         std::tie(pos, node) = stack.top();
         stack.pop();
     }
+
+    return true;
 }
 
 void
@@ -136,10 +234,14 @@ SHAMap::visitDifferences(
             return;
 
         // 2) push non-matching child inner nodes
+        bool entered = true;
         for (int i = 0; i < 16; ++i)
         {
             if (!node->isEmptyBranch(i))
             {
+                readAhead(node, i, entered);
+                entered = false;
+
                 auto const& childHash = node->getChildHash(i);
                 SHAMapNodeID childID = nodeID.getChildNodeID(i);
                 auto next = descendThrow(node, i);
@@ -308,42 +410,12 @@ SHAMap::gmn_ProcessDeferredReads(MissingNodes& mn)
     mn.deferred_ = 0;
 }
 
-/** Get a list of node IDs and hashes for nodes that are part of this SHAMap
-    but not available locally.  The filter can hold alternate sources of
-    nodes that are not permanently stored locally
-*/
-std::vector<std::pair<SHAMapNodeID, uint256>>
-SHAMap::getMissingNodes(int max, SHAMapSyncFilter* filter)
+// Traverse the subtree rooted at the specified StackEntry,
+// posting deferred reads and recording missing nodes in mn,
+// until the subtree is complete or mn.max_ is exhausted.
+void
+SHAMap::gmn_Traverse(MissingNodes& mn, MissingNodes::StackEntry pos)
 {
-    assert(root_->getHash().isNonZero());
-    assert(max > 0);
-
-    MissingNodes mn(
-        max,
-        filter,
-        4096,  // number of async reads per pass
-        f_.getFullBelowCache(ledgerSeq_)->getGeneration());
-
-    if (!root_->isInner() ||
-        std::static_pointer_cast<SHAMapInnerNode>(root_)->isFullBelow(
-            mn.generation_))
-    {
-        clearSynching();
-        return std::move(mn.missingNodes_);
-    }
-
-    // Start at the root.
-    // The firstChild value is selected randomly so if multiple threads
-    // are traversing the map, each thread will start at a different
-    // (randomly selected) inner node.  This increases the likelihood
-    // that the two threads will produce different request sets (which is
-    // more efficient than sending identical requests).
-    MissingNodes::StackEntry pos{
-        static_cast<SHAMapInnerNode*>(root_.get()),
-        SHAMapNodeID(),
-        rand_int(255),
-        0,
-        true};
     auto& node = std::get<0>(pos);
     auto& nextChild = std::get<3>(pos);
     auto& fullBelow = std::get<4>(pos);
@@ -385,7 +457,7 @@ SHAMap::getMissingNodes(int max, SHAMapSyncFilter* filter)
             gmn_ProcessDeferredReads(mn);
 
         if (mn.max_ <= 0)
-            return std::move(mn.missingNodes_);
+            return;
 
         if (node == nullptr)
         {  // We weren't in the middle of processing a node
@@ -415,6 +487,185 @@ SHAMap::getMissingNodes(int max, SHAMapSyncFilter* filter)
         // and we have no nodes to resume
 
     } while (node != nullptr);
+}
+
+// Fetch the children of the root here, then traverse the
+// subtrees below its inner children concurrently. The subtrees
+// are disjoint, so each thread gets its own MissingNodes and
+// its share of the deferred reads; the results are merged into mn.
+void
+SHAMap::gmn_ProcessParallel(MissingNodes& mn, std::size_t threads)
+{
+    auto const root = static_cast<SHAMapInnerNode*>(root_.get());
+    bool fullBelow = true;
+
+    std::vector<MissingNodes::StackEntry> subtrees;
+    int const firstChild = rand_int(255);
+    for (int i = 0; i < branchFactor; ++i)
+    {
+        int const branch = (firstChild + i) % branchFactor;
+        if (root->isEmptyBranch(branch))
+            continue;
+
+        auto const& childHash = root->getChildHash(branch);
+        if (backed_ &&
+            f_.getFullBelowCache(ledgerSeq_)
+                ->touch_if_exists(childHash.as_uint256()))
+            continue;
+
+        auto const [child, childID] =
+            descend(root, SHAMapNodeID(), branch, mn.filter_);
+        if (!child)
+        {
+            fullBelow = false;
+            mn.missingHashes_.insert(childHash);
+            mn.missingNodes_.emplace_back(childID, childHash.as_uint256());
+
+            if (--mn.max_ <= 0)
+                return;
+        }
+        else if (
+            child->isInner() &&
+            !static_cast<SHAMapInnerNode*>(child)->isFullBelow(mn.generation_))
+        {
+            subtrees.emplace_back(
+                static_cast<SHAMapInnerNode*>(child),
+                childID,
+                rand_int(255),
+                0,
+                true);
+        }
+    }
+
+    threads = std::min(threads, subtrees.size());
+    std::vector<std::unique_ptr<MissingNodes>> results;
+    results.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+        results.push_back(std::make_unique<MissingNodes>(
+            mn.max_,
+            mn.filter_,
+            std::max(1, mn.maxDefer_ / static_cast<int>(threads)),
+            mn.generation_));
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<int> found{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto work = [&](MissingNodes& wmn) {
+        try
+        {
+            for (std::size_t i; (i = next++) < subtrees.size();)
+            {
+                if (found >= mn.max_)
+                    break;
+
+                auto const before = wmn.missingNodes_.size();
+                gmn_Traverse(wmn, subtrees[i]);
+                found += wmn.missingNodes_.size() - before;
+
+                if (wmn.max_ <= 0)
+                    break;
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    if (threads > 1)
+    {
+        workers.reserve(threads - 1);
+        for (std::size_t i = 1; i < threads; ++i)
+            workers.emplace_back(work, std::ref(*results[i]));
+    }
+    if (threads > 0)
+        work(*results[0]);
+    for (auto& w : workers)
+        w.join();
+
+    if (error)
+        std::rethrow_exception(error);
+
+    for (auto const& wmn : results)
+    {
+        for (auto const& [nodeID, hash] : wmn->missingNodes_)
+        {
+            if (mn.max_ <= 0)
+                return;
+
+            if (mn.missingHashes_.insert(SHAMapHash{hash}).second)
+            {
+                mn.missingNodes_.emplace_back(nodeID, hash);
+                --mn.max_;
+            }
+        }
+    }
+
+    for (auto const& se : subtrees)
+        fullBelow =
+            fullBelow && std::get<0>(se)->isFullBelow(mn.generation_);
+
+    if (fullBelow)
+    {
+        root->setFullBelowGen(mn.generation_);
+        if (backed_)
+        {
+            f_.getFullBelowCache(ledgerSeq_)
+                ->insert(root->getHash().as_uint256());
+        }
+    }
+}
+
+/** Get a list of node IDs and hashes for nodes that are part of this SHAMap
+    but not available locally.  The filter can hold alternate sources of
+    nodes that are not permanently stored locally
+*/
+std::vector<std::pair<SHAMapNodeID, uint256>>
+SHAMap::getMissingNodes(
+    int max,
+    SHAMapSyncFilter* filter,
+    std::size_t threads)
+{
+    assert(root_->getHash().isNonZero());
+    assert(max > 0);
+
+    MissingNodes mn(
+        max,
+        filter,
+        4096,  // number of async reads per pass
+        f_.getFullBelowCache(ledgerSeq_)->getGeneration());
+
+    if (!root_->isInner() ||
+        std::static_pointer_cast<SHAMapInnerNode>(root_)->isFullBelow(
+            mn.generation_))
+    {
+        clearSynching();
+        return std::move(mn.missingNodes_);
+    }
+
+    if (threads > 1)
+        gmn_ProcessParallel(mn, threads);
+    else
+    {
+        // Start at the root.
+        // The firstChild value is selected randomly so if multiple threads
+        // are traversing the map, each thread will start at a different
+        // (randomly selected) inner node.  This increases the likelihood
+        // that the two threads will produce different request sets (which is
+        // more efficient than sending identical requests).
+        MissingNodes::StackEntry pos{
+            static_cast<SHAMapInnerNode*>(root_.get()),
+            SHAMapNodeID(),
+            rand_int(255),
+            0,
+            true};
+        gmn_Traverse(mn, std::move(pos));
+    }
 
     if (mn.missingNodes_.empty())
         clearSynching();
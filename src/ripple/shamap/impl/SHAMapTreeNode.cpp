@@ -57,21 +57,14 @@ SHAMapTreeNode::makeTransactionWithMeta(
     SHAMapHash const& hash,
     bool hashValid)
 {
-    Serializer s(data.data(), data.size());
-
-    uint256 tag;
-
-    if (s.size() < tag.bytes)
+    if (data.size() < uint256::bytes)
         Throw<std::runtime_error>("Short TXN+MD node");
 
-    // FIXME: improve this interface so that the above check isn't needed
-    if (!s.getBitString(tag, s.size() - tag.bytes))
-        Throw<std::out_of_range>(
-            "Short TXN+MD node (" + std::to_string(s.size()) + ")");
-
-    s.chop(tag.bytes);
+    // The tag is the last 256 bits of the node
+    data.remove_suffix(uint256::bytes);
+    auto const tag = uint256::fromVoid(data.data() + data.size());
 
-    auto item = std::make_shared<SHAMapItem const>(tag, s.slice());
+    auto item = std::make_shared<SHAMapItem const>(tag, data);
 
     if (hashValid)
         return std::make_shared<SHAMapTxPlusMetaLeafNode>(
@@ -86,24 +79,17 @@ SHAMapTreeNode::makeAccountState(
     SHAMapHash const& hash,
     bool hashValid)
 {
-    Serializer s(data.data(), data.size());
-
-    uint256 tag;
-
-    if (s.size() < tag.bytes)
+    if (data.size() < uint256::bytes)
         Throw<std::runtime_error>("short AS node");
 
-    // FIXME: improve this interface so that the above check isn't needed
-    if (!s.getBitString(tag, s.size() - tag.bytes))
-        Throw<std::out_of_range>(
-            "Short AS node (" + std::to_string(s.size()) + ")");
-
-    s.chop(tag.bytes);
+    // The tag is the last 256 bits of the node
+    data.remove_suffix(uint256::bytes);
+    auto const tag = uint256::fromVoid(data.data() + data.size());
 
     if (tag.isZero())
         Throw<std::runtime_error>("Invalid AS node");
 
-    auto item = std::make_shared<SHAMapItem const>(tag, s.slice());
+    auto item = std::make_shared<SHAMapItem const>(tag, data);
 
     if (hashValid)
         return std::make_shared<SHAMapAccountStateLeafNode>(
@@ -22,6 +22,7 @@
 #include <ripple/app/main/Tuning.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/shamap/ShardFamily.h>
+#include <thread>
 
 namespace ripple {
 
@@ -123,7 +124,8 @@ ShardFamily::sweep()
     std::lock_guard lock(tnCacheMutex_);
     for (auto it = tnCache_.cbegin(); it != tnCache_.cend();)
     {
-        it->second->sweep();
+        while (!it->second->sweepSlice(treeCacheSweepSlice))
+            std::this_thread::yield();
 
         // Remove cache if empty
         if (it->second->getTrackSize() == 0)
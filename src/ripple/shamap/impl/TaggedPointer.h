@@ -20,6 +20,7 @@
 #ifndef RIPPLE_SHAMAP_TAGGEDPOINTER_H_INCLUDED
 #define RIPPLE_SHAMAP_TAGGEDPOINTER_H_INCLUDED
 
+#include <ripple/json/json_value.h>
 #include <ripple/shamap/SHAMapTreeNode.h>
 
 #include <cstdint>
@@ -149,6 +150,10 @@ public:
 
     ~TaggedPointer();
 
+    /** Add the allocation counts for each size of array to `obj`. */
+    static void
+    getCountsJson(Json::Value& obj);
+
     /** Decode the tagged pointer into its tag and pointer */
     [[nodiscard]] std::pair<std::uint8_t, void*>
     decode() const;
@@ -19,12 +19,12 @@
 
 #include <ripple/shamap/impl/TaggedPointer.h>
 
+#include <ripple/basics/SlabAllocator.h>
+#include <ripple/protocol/jss.h>
 #include <ripple/shamap/SHAMapInnerNode.h>
 
 #include <array>
 
-#include <boost/pool/pool_alloc.hpp>
-
 namespace ripple {
 
 namespace {
@@ -45,9 +45,9 @@ static_assert(
     boundaries.back() == SHAMapInnerNode::branchFactor,
     "Last element of boundaries must be number of children in a dense array");
 
-// Terminology: A chunk is the memory being allocated from a block. A block
-// contains multiple chunks. This is the terminology the boost documentation
-// uses. Pools use "Simple Segregated Storage" as their storage format.
+// Terminology: A chunk is the memory being allocated from a block (slab). A
+// block contains multiple chunks. Each array size has its own allocator,
+// which serves most requests from a per-thread cache of free chunks.
 constexpr size_t elementSizeBytes =
     (sizeof(SHAMapHash) + sizeof(std::shared_ptr<SHAMapTreeNode>));
 
@@ -64,16 +64,8 @@ constexpr std::array<size_t, boundaries.size()> initArrayChunkSizeBytes(
 constexpr auto arrayChunkSizeBytes =
     initArrayChunkSizeBytes(std::make_index_sequence<boundaries.size()>{});
 
-template <std::size_t... I>
-constexpr std::array<size_t, boundaries.size()> initArrayChunksPerBlock(
-    std::index_sequence<I...>)
-{
-    return std::array<size_t, boundaries.size()>{
-        blockSizeBytes / arrayChunkSizeBytes[I]...,
-    };
-}
-constexpr auto chunksPerBlock =
-    initArrayChunksPerBlock(std::make_index_sequence<boundaries.size()>{});
+template <std::size_t I>
+using ArrayAllocator = SlabAllocator<arrayChunkSizeBytes[I], blockSizeBytes>;
 
 [[nodiscard]] inline std::uint8_t
 numAllocatedChildren(std::uint8_t n)
@@ -96,13 +88,7 @@ std::array<std::function<void*()>, boundaries.size()> initAllocateArrayFuns(
     std::index_sequence<I...>)
 {
     return std::array<std::function<void*()>, boundaries.size()>{
-        boost::singleton_pool<
-            boost::fast_pool_allocator_tag,
-            arrayChunkSizeBytes[I],
-            boost::default_user_allocator_new_delete,
-            std::mutex,
-            chunksPerBlock[I],
-            chunksPerBlock[I]>::malloc...,
+        ArrayAllocator<I>::allocate...,
     };
 }
 std::array<std::function<void*()>, boundaries.size()> const allocateArrayFuns =
@@ -113,13 +99,7 @@ std::array<std::function<void(void*)>, boundaries.size()> initFreeArrayFuns(
     std::index_sequence<I...>)
 {
     return std::array<std::function<void(void*)>, boundaries.size()>{
-        static_cast<void (*)(void*)>(boost::singleton_pool<
-                                     boost::fast_pool_allocator_tag,
-                                     arrayChunkSizeBytes[I],
-                                     boost::default_user_allocator_new_delete,
-                                     std::mutex,
-                                     chunksPerBlock[I],
-                                     chunksPerBlock[I]>::free)...,
+        ArrayAllocator<I>::deallocate...,
     };
 }
 std::array<std::function<void(void*)>, boundaries.size()> const freeArrayFuns =
@@ -130,19 +110,20 @@ std::array<std::function<bool(void*)>, boundaries.size()> initIsFromArrayFuns(
     std::index_sequence<I...>)
 {
     return std::array<std::function<bool(void*)>, boundaries.size()>{
-        boost::singleton_pool<
-            boost::fast_pool_allocator_tag,
-            arrayChunkSizeBytes[I],
-            boost::default_user_allocator_new_delete,
-            std::mutex,
-            chunksPerBlock[I],
-            chunksPerBlock[I]>::is_from...,
+        ArrayAllocator<I>::owns...,
     };
 }
 std::array<std::function<bool(void*)>, boundaries.size()> const
     isFromArrayFuns =
         initIsFromArrayFuns(std::make_index_sequence<boundaries.size()>{});
 
+template <std::size_t... I>
+std::array<SlabAllocatorStats, boundaries.size()>
+getArrayAllocatorStats(std::index_sequence<I...>)
+{
+    return {ArrayAllocator<I>::stats()...};
+}
+
 // This function returns an untagged pointer
 [[nodiscard]] inline std::pair<std::uint8_t, void*>
 allocateArrays(std::uint8_t numChildren)
@@ -188,6 +169,23 @@ static SHAMapHash const zeroSHAMapHash;
 
 }  // namespace
 
+void
+TaggedPointer::getCountsJson(Json::Value& obj)
+{
+    auto const stats = getArrayAllocatorStats(
+        std::make_index_sequence<boundaries.size()>{});
+
+    Json::Value& jv = (obj[jss::inner_node_arrays] = Json::objectValue);
+    for (std::size_t i = 0; i < boundaries.size(); ++i)
+    {
+        Json::Value& sizeClass =
+            (jv[std::to_string(boundaries[i])] = Json::objectValue);
+        sizeClass[jss::allocations] = std::to_string(stats[i].allocations);
+        sizeClass[jss::deallocations] = std::to_string(stats[i].deallocations);
+        sizeClass[jss::reserved_bytes] = std::to_string(stats[i].reservedBytes);
+    }
+}
+
 template <class F>
 void
 TaggedPointer::iterChildren(std::uint16_t isBranch, F&& f) const
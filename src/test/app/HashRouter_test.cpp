@@ -20,6 +20,12 @@
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <atomic>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
 
 namespace ripple {
 namespace test {
@@ -141,12 +147,12 @@ class HashRouter_test : public beast::unit_test::suite
     }
 
     void
-    testSuppression()
+    testSuppression(std::size_t shards)
     {
         // Normal HashRouter
         using namespace std::chrono_literals;
         TestStopwatch stopwatch;
-        HashRouter router(stopwatch, 2s, 2);
+        HashRouter router(stopwatch, 2s, 2, shards);
 
         uint256 const key1(1);
         uint256 const key2(2);
@@ -170,11 +176,11 @@ class HashRouter_test : public beast::unit_test::suite
     }
 
     void
-    testSetFlags()
+    testSetFlags(std::size_t shards)
     {
         using namespace std::chrono_literals;
         TestStopwatch stopwatch;
-        HashRouter router(stopwatch, 2s, 2);
+        HashRouter router(stopwatch, 2s, 2, shards);
 
         uint256 const key1(1);
         BEAST_EXPECT(router.setFlags(key1, 10));
@@ -183,11 +189,11 @@ class HashRouter_test : public beast::unit_test::suite
     }
 
     void
-    testRelay()
+    testRelay(std::size_t shards)
     {
         using namespace std::chrono_literals;
         TestStopwatch stopwatch;
-        HashRouter router(stopwatch, 1s, 2);
+        HashRouter router(stopwatch, 1s, 2, shards);
 
         uint256 const key1(1);
 
@@ -226,11 +232,11 @@ class HashRouter_test : public beast::unit_test::suite
     }
 
     void
-    testRecover()
+    testRecover(std::size_t shards)
     {
         using namespace std::chrono_literals;
         TestStopwatch stopwatch;
-        HashRouter router(stopwatch, 1s, 5);
+        HashRouter router(stopwatch, 1s, 5, shards);
 
         uint256 const key1(1);
 
@@ -261,11 +267,11 @@ class HashRouter_test : public beast::unit_test::suite
     }
 
     void
-    testProcess()
+    testProcess(std::size_t shards)
     {
         using namespace std::chrono_literals;
         TestStopwatch stopwatch;
-        HashRouter router(stopwatch, 5s, 5);
+        HashRouter router(stopwatch, 5s, 5, shards);
         uint256 const key(1);
         HashRouter::PeerShortID peer = 1;
         int flags;
@@ -277,21 +283,137 @@ class HashRouter_test : public beast::unit_test::suite
         BEAST_EXPECT(router.shouldProcess(key, peer, flags, 1s));
     }
 
+    void
+    testShards()
+    {
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, 2s, 2, 4);
+        BEAST_EXPECT(router.shards() == 4);
+
+        // Enough keys that every shard sees some of them
+        std::vector<uint256> oldKeys;
+        std::vector<uint256> newKeys;
+        for (int i = 1; i <= 256; ++i)
+        {
+            oldKeys.emplace_back(i);
+            newKeys.emplace_back(i + 256);
+        }
+
+        // t=0
+        for (auto const& key : oldKeys)
+            BEAST_EXPECT(router.setFlags(key, 11111));
+        for (auto const& key : oldKeys)
+            BEAST_EXPECT(router.getFlags(key) == 11111);
+
+        ++stopwatch;
+        ++stopwatch;
+        ++stopwatch;
+
+        // t=3
+        // Each shard expires its own entries when a new
+        // hash is inserted into it.
+        for (auto const& key : newKeys)
+            BEAST_EXPECT(router.setFlags(key, 22222));
+        for (auto const& key : oldKeys)
+            BEAST_EXPECT(router.getFlags(key) == 0);
+        for (auto const& key : newKeys)
+            BEAST_EXPECT(router.getFlags(key) == 22222);
+    }
+
 public:
     void
     run() override
     {
         testNonExpiration();
         testExpiration();
-        testSuppression();
-        testSetFlags();
-        testRelay();
-        testRecover();
-        testProcess();
+        for (std::size_t shards : {1, 16})
+        {
+            testSuppression(shards);
+            testSetFlags(shards);
+            testRelay(shards);
+            testRecover(shards);
+            testProcess(shards);
+        }
+        testShards();
+    }
+};
+
+//------------------------------------------------------------------------------
+
+// Measures relay-path throughput when many peer threads share one router
+class HashRouterContention_test : public beast::unit_test::suite
+{
+    static constexpr int keys = 1 << 16;
+    static constexpr std::size_t operations = 1 << 20;
+
+    void
+    measure(std::size_t shards, std::size_t threads)
+    {
+        using namespace std::chrono;
+        TestStopwatch stopwatch;
+        HashRouter router(
+            stopwatch,
+            HashRouter::getDefaultHoldTime(),
+            HashRouter::getDefaultRecoverLimit(),
+            shards);
+
+        std::vector<uint256> hashes;
+        hashes.reserve(keys);
+        for (int i = 0; i < keys; ++i)
+            hashes.emplace_back(i + 1);
+
+        std::atomic<std::size_t> relayed{0};
+        auto const start = steady_clock::now();
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t] {
+                beast::xor_shift_engine gen(t + 1);
+                std::uniform_int_distribution<int> dist(0, keys - 1);
+                auto const peer = static_cast<HashRouter::PeerShortID>(t + 1);
+                std::size_t count = 0;
+                for (std::size_t i = 0; i < operations / threads; ++i)
+                {
+                    auto const& hash = hashes[dist(gen)];
+                    if (router.addSuppressionPeer(hash, peer))
+                    {
+                        router.setFlags(hash, SF_TRUSTED);
+                        if (router.shouldRelay(hash))
+                            ++count;
+                    }
+                }
+                relayed += count;
+            });
+        }
+        for (auto& w : workers)
+            w.join();
+        auto const elapsed =
+            duration_cast<milliseconds>(steady_clock::now() - start);
+
+        BEAST_EXPECT(relayed > 0 && relayed <= keys);
+        log << std::setw(4) << router.shards() << " shards, " << std::setw(2)
+            << threads << " threads: " << elapsed.count() << "ms"
+            << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("contention");
+
+        for (std::size_t threads : {1, 2, 4, 8, 16})
+        {
+            measure(1, threads);
+            measure(HashRouter::getDefaultShards(), threads);
+        }
     }
 };
 
 BEAST_DEFINE_TESTSUITE(HashRouter, app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(HashRouterContention, app, ripple);
 
 }  // namespace test
 }  // namespace ripple
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/LatencyHistogram.h>
+#include <ripple/beast/unit_test.h>
+
+namespace ripple {
+
+class LatencyHistogram_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono_literals;
+        using H = LatencyHistogram;
+
+        {
+            H h;
+            auto const counts = h.snapshot();
+            BEAST_EXPECT(H::total(counts) == 0);
+            BEAST_EXPECT(H::percentile(counts, 99) == 0us);
+        }
+
+        // Small latencies are counted exactly
+        {
+            H h;
+            for (auto us = 0; us < 16; ++us)
+                h.record(std::chrono::microseconds(us));
+            auto const counts = h.snapshot();
+            BEAST_EXPECT(H::total(counts) == 16);
+            BEAST_EXPECT(H::percentile(counts, 0) == 0us);
+            BEAST_EXPECT(H::percentile(counts, 50) == 7us);
+            BEAST_EXPECT(H::percentile(counts, 100) == 15us);
+        }
+
+        // Larger latencies are within an eighth of the truth
+        {
+            for (auto const us : {16, 17, 100, 999, 12345, 4000000})
+            {
+                H h;
+                h.record(std::chrono::microseconds(us));
+                auto const p = H::percentile(h.snapshot(), 50).count();
+                BEAST_EXPECT(p >= us);
+                BEAST_EXPECT(p <= us + us / 8);
+            }
+        }
+
+        // The tail is found among many fast samples
+        {
+            H h;
+            for (auto i = 0; i < 990; ++i)
+                h.record(100us);
+            for (auto i = 0; i < 10; ++i)
+                h.record(50ms);
+            auto const counts = h.snapshot();
+            BEAST_EXPECT(H::percentile(counts, 50) < 110us);
+            BEAST_EXPECT(H::percentile(counts, 99) < 110us);
+            BEAST_EXPECT(H::percentile(counts, 99.9) >= 50ms);
+            BEAST_EXPECT(H::percentile(counts, 99.9) < 57ms);
+        }
+
+        // Latencies past the range land in the last bucket, and counts
+        // since a snapshot exclude what came before it
+        {
+            H h;
+            h.record(-5us);
+            h.record(std::chrono::hours(100));
+            auto const before = h.snapshot();
+            BEAST_EXPECT(H::total(before) == 2);
+            BEAST_EXPECT(H::percentile(before, 50) == 0us);
+            BEAST_EXPECT(H::percentile(before, 100) > std::chrono::hours(38));
+
+            h.record(1ms);
+            auto const delta = H::since(h.snapshot(), before);
+            BEAST_EXPECT(H::total(delta) == 1);
+            BEAST_EXPECT(H::percentile(delta, 100) >= 1ms);
+            BEAST_EXPECT(H::percentile(delta, 100) < 1125us);
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LatencyHistogram, basics, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/SlabAllocator.h>
+#include <ripple/beast/unit_test.h>
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+class SlabAllocator_test : public beast::unit_test::suite
+{
+    // Each test uses its own chunk size so its statistics are independent
+    template <std::size_t ChunkSize>
+    using Allocator = SlabAllocator<ChunkSize, 4096, 8>;
+
+public:
+    void
+    testReuse()
+    {
+        testcase("reuse");
+
+        using A = Allocator<48>;
+
+        std::vector<void*> chunks;
+        for (int i = 0; i < 200; ++i)
+        {
+            auto p = A::allocate();
+            BEAST_EXPECT(A::owns(p));
+            std::memset(p, i, 48);
+            chunks.push_back(p);
+        }
+
+        // Every chunk is distinct and none overlap
+        std::sort(chunks.begin(), chunks.end());
+        BEAST_EXPECT(
+            std::adjacent_find(
+                chunks.begin(), chunks.end(), [](void* a, void* b) {
+                    return static_cast<char*>(b) - static_cast<char*>(a) < 48;
+                }) == chunks.end());
+
+        int x = 0;
+        BEAST_EXPECT(!A::owns(&x));
+
+        auto const slabs = A::stats().slabs;
+        BEAST_EXPECT(slabs == (200 + 84) / 85);
+
+        // Freed chunks are handed out again before new slabs are carved
+        for (auto p : chunks)
+            A::deallocate(p);
+        std::set<void*> const freed(chunks.begin(), chunks.end());
+        chunks.clear();
+        for (int i = 0; i < 200; ++i)
+        {
+            chunks.push_back(A::allocate());
+            BEAST_EXPECT(freed.count(chunks.back()) == 1);
+        }
+        BEAST_EXPECT(A::stats().slabs == slabs);
+        BEAST_EXPECT(A::stats().reservedBytes == slabs * 4096);
+
+        for (auto p : chunks)
+            A::deallocate(p);
+    }
+
+    void
+    testThreads()
+    {
+        testcase("threads");
+
+        using A = Allocator<96>;
+
+        // Chunks allocated on one thread may be freed on another, and
+        // every operation is counted once the threads have exited.
+        std::vector<void*> chunks(1000);
+        std::thread([&] {
+            for (auto& p : chunks)
+                p = A::allocate();
+        }).join();
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&, t] {
+                for (std::size_t i = t; i < chunks.size(); i += 4)
+                    A::deallocate(chunks[i]);
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+
+        auto const stats = A::stats();
+        BEAST_EXPECT(stats.allocations == 1000);
+        BEAST_EXPECT(stats.deallocations == 1000);
+    }
+
+    void
+    run() override
+    {
+        testReuse();
+        testThreads();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SlabAllocator, basics, ripple);
+
+}  // namespace ripple
@@ -21,7 +21,13 @@
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/clock/manual_clock.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
 #include <test/unit_test/SuiteJournal.h>
+#include <atomic>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
 
 namespace ripple {
 
@@ -37,10 +43,17 @@ original object.
 
 class TaggedCache_test : public beast::unit_test::suite
 {
-public:
+    using Key = int;
+    using Value = std::string;
+
+    template <class Cache>
     void
-    run() override
+    testCache()
     {
+        testcase(
+            "partitions " + std::to_string(Cache::partitions()),
+            beast::unit_test::abort_on_fail);
+
         using namespace std::chrono_literals;
         using namespace beast::severities;
         test::SuiteJournal journal("TaggedCache_test", *this);
@@ -48,10 +61,6 @@ public:
         TestStopwatch clock;
         clock.set(0);
 
-        using Key = int;
-        using Value = std::string;
-        using Cache = TaggedCache<Key, Value>;
-
         Cache c("test", 1, 1s, clock, journal);
 
         // Insert an item, retrieve it, and age it so it gets purged.
@@ -147,9 +156,158 @@ public:
             BEAST_EXPECT(c.getCacheSize() == 0);
             BEAST_EXPECT(c.getTrackSize() == 0);
         }
+
+        // Keys spread over every partition are counted and swept together.
+        {
+            for (Key k = 0; k < 100; ++k)
+                BEAST_EXPECT(!c.insert(k, std::to_string(k)));
+            BEAST_EXPECT(c.getCacheSize() == 100);
+            BEAST_EXPECT(c.getTrackSize() == 100);
+            BEAST_EXPECT(c.getKeys().size() == 100);
+
+            for (Key k = 0; k < 100; ++k)
+            {
+                Value v;
+                BEAST_EXPECT(c.retrieve(k, v));
+                BEAST_EXPECT(v == std::to_string(k));
+            }
+
+            BEAST_EXPECT(c.del(42, false));
+            BEAST_EXPECT(!c.fetch(42));
+            BEAST_EXPECT(c.getCacheSize() == 99);
+            BEAST_EXPECT(c.getTrackSize() == 99);
+
+            ++clock;
+            c.sweep();
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 0);
+        }
+
+        // Sweep in slices: nothing young is expired, and a complete pass
+        // over expired entries takes several calls and removes them all.
+        {
+            for (Key k = 0; k < 100; ++k)
+                BEAST_EXPECT(!c.insert(k, std::to_string(k)));
+            auto const p = c.fetch(7);
+
+            while (!c.sweepSlice(10))
+                ;
+            BEAST_EXPECT(c.getCacheSize() == 100);
+
+            ++clock;
+            int calls = 1;
+            while (!c.sweepSlice(10))
+                ++calls;
+            BEAST_EXPECT(calls > 1);
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 1);
+            BEAST_EXPECT(c.fetch(7) == p);
+            BEAST_EXPECT(c.getCacheSize() == 1);
+        }
+
+        c.reset();
+        BEAST_EXPECT(c.getTrackSize() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testCache<TaggedCache<Key, Value>>();
+        testCache<TaggedCache<
+            Key,
+            Value,
+            hardened_hash<>,
+            std::equal_to<Key>,
+            std::recursive_mutex,
+            16>>();
+    }
+};
+
+//------------------------------------------------------------------------------
+
+// Measures fetch/canonicalize throughput when many threads share one cache
+class TaggedCacheContention_test : public beast::unit_test::suite
+{
+    using Key = int;
+    using Value = std::string;
+
+    static constexpr int keys = 1 << 16;
+    static constexpr std::size_t operations = 1 << 20;
+
+    template <class Cache>
+    void
+    measure(std::size_t threads)
+    {
+        using namespace std::chrono;
+        test::SuiteJournal journal("TaggedCacheContention_test", *this);
+        TestStopwatch clock;
+        clock.set(0);
+
+        Cache c("test", keys, 1min, clock, journal);
+        for (Key k = 0; k < keys; k += 2)
+            c.insert(k, std::to_string(k));
+
+        std::atomic<std::size_t> found{0};
+        auto const start = steady_clock::now();
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t] {
+                beast::xor_shift_engine gen(t + 1);
+                std::uniform_int_distribution<Key> dist(0, keys - 1);
+                std::size_t hits = 0;
+                for (std::size_t i = 0; i < operations / threads; ++i)
+                {
+                    auto const k = dist(gen);
+                    if (c.fetch(k))
+                    {
+                        ++hits;
+                    }
+                    else
+                    {
+                        auto v = std::make_shared<Value>(std::to_string(k));
+                        c.canonicalize_replace_client(k, v);
+                    }
+                }
+                found += hits;
+            });
+        }
+        for (auto& w : workers)
+            w.join();
+        auto const elapsed =
+            duration_cast<milliseconds>(steady_clock::now() - start);
+
+        BEAST_EXPECT(found > 0);
+        log << std::setw(4) << Cache::partitions() << " partitions, "
+            << std::setw(2) << threads << " threads: " << elapsed.count()
+            << "ms" << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("contention");
+
+        using Striped = TaggedCache<
+            Key,
+            Value,
+            hardened_hash<>,
+            std::equal_to<Key>,
+            std::recursive_mutex,
+            64>;
+
+        for (std::size_t threads : {1, 2, 4, 8, 16})
+        {
+            measure<TaggedCache<Key, Value>>(threads);
+            measure<Striped>(threads);
+        }
     }
 };
 
 BEAST_DEFINE_TESTSUITE(TaggedCache, common, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(TaggedCacheContention, common, ripple);
 
 }  // namespace ripple
@@ -18,10 +18,13 @@
 //==============================================================================
 
 #include <ripple/beast/utility/temp_dir.h>
+#include <ripple/nodestore/CodecDictionary.h>
 #include <ripple/nodestore/DummyScheduler.h>
 #include <ripple/nodestore/Manager.h>
 #include <ripple/unity/rocksdb.h>
 #include <algorithm>
+#include <boost/filesystem.hpp>
+#include <fstream>
 #include <test/nodestore/TestBase.h>
 #include <test/unit_test/SuiteJournal.h>
 
@@ -98,6 +101,97 @@ public:
         }
     }
 
+    // Objects sharing most of their contents, as ledger entries do
+    static Batch
+    createStructuredBatch(int numObjects, std::uint64_t seed)
+    {
+        Batch batch;
+        batch.reserve(numObjects);
+
+        beast::xor_shift_engine rng(seed);
+
+        for (int i = 0; i < numObjects; ++i)
+        {
+            uint256 hash;
+            beast::rngfill(hash.begin(), hash.size(), rng);
+
+            Blob blob(64 + rand_int(rng, 16, 32));
+            for (int j = 0; j < 64; ++j)
+                blob[j] = static_cast<std::uint8_t>(j * 7);
+            beast::rngfill(blob.data() + 64, blob.size() - 64, rng);
+
+            batch.push_back(NodeObject::createObject(
+                hotACCOUNT_NODE, std::move(blob), hash));
+        }
+
+        return batch;
+    }
+
+    void
+    testDictionary(std::uint64_t const seedValue)
+    {
+        DummyScheduler scheduler;
+
+        testcase("Backend dictionary");
+
+        beast::temp_dir tempDir;
+        beast::temp_dir dictDir;
+        auto const dictPath = dictDir.file("dict");
+        Section params;
+        params.set("type", "nudb");
+        params.set("path", tempDir.path());
+
+        beast::xor_shift_engine rng(seedValue);
+        auto const before = createStructuredBatch(numObjectsToTest, rng());
+        auto const after = createStructuredBatch(numObjectsToTest, rng());
+
+        test::SuiteJournal journal("Backend_test", *this);
+
+        {
+            // Write lz4 objects, then train a dictionary from them
+            auto backend = Manager::instance().make_Backend(
+                params, megabytes(4), scheduler, journal);
+            backend->open();
+            storeBatch(*backend, before);
+
+            auto const dict = trainCodecDictionary(*backend, 1000, 4096);
+            std::ofstream file(dictPath, std::ios::binary);
+            file.write(reinterpret_cast<char const*>(dict.data()), dict.size());
+        }
+
+        params.set("compression_dictionary", dictPath);
+        {
+            // Embed the dictionary and write objects with it
+            auto backend = Manager::instance().make_Backend(
+                params, megabytes(4), scheduler, journal);
+            backend->open();
+            storeBatch(*backend, after);
+
+            Batch copy;
+            fetchCopyOfBatch(*backend, &copy, before);
+            BEAST_EXPECT(areBatchesEqual(before, copy));
+            fetchCopyOfBatch(*backend, &copy, after);
+            BEAST_EXPECT(areBatchesEqual(after, copy));
+        }
+
+        // Everything must stay readable once the file is gone
+        boost::filesystem::remove(dictPath);
+        params.set("compression_dictionary", "");
+        {
+            auto backend = Manager::instance().make_Backend(
+                params, megabytes(4), scheduler, journal);
+            backend->open();
+
+            Batch copy;
+            fetchCopyOfBatch(*backend, &copy, after);
+            BEAST_EXPECT(areBatchesEqual(after, copy));
+
+            std::size_t count = 0;
+            backend->for_each([&](std::shared_ptr<NodeObject>) { ++count; });
+            BEAST_EXPECT(count == before.size() + after.size());
+        }
+    }
+
     //--------------------------------------------------------------------------
 
     void
@@ -106,6 +200,7 @@ public:
         std::uint64_t const seedValue = 50;
 
         testBackend("nudb", seedValue);
+        testDictionary(seedValue);
 
 #if RIPPLE_ROCKSDB_AVAILABLE
         testBackend("rocksdb", seedValue);
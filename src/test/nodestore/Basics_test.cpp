@@ -17,8 +17,10 @@
 */
 //==============================================================================
 
+#include <ripple/basics/Buffer.h>
 #include <ripple/nodestore/DummyScheduler.h>
 #include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/BloomFilter.h>
 #include <ripple/nodestore/impl/DecodedBlob.h>
 #include <ripple/nodestore/impl/EncodedBlob.h>
 #include <test/nodestore/TestBase.h>
@@ -76,6 +78,69 @@ public:
         }
     }
 
+    // Checks decoding blobs in place, without copying them
+    void
+    testSharedBlobs(std::uint64_t const seedValue)
+    {
+        testcase("shared encoding");
+
+        auto batch = createPredictableBatch(numObjectsToTest, seedValue);
+
+        std::vector<std::shared_ptr<NodeObject>> objects;
+        for (int i = 0; i < batch.size(); ++i)
+        {
+            std::shared_ptr<Buffer> buffer;
+            {
+                EncodedBlob encoded;
+                encoded.prepare(batch[i]);
+                buffer = std::make_shared<Buffer>(
+                    encoded.getData(), encoded.getSize());
+            }
+
+            DecodedBlob decoded(
+                batch[i]->getHash().data(), buffer->data(), buffer->size());
+
+            BEAST_EXPECT(decoded.wasOk());
+
+            if (decoded.wasOk())
+            {
+                auto const data = buffer->data();
+                objects.push_back(decoded.createObject(std::move(buffer)));
+                BEAST_EXPECT(objects.back()->getData().data() == data + 9);
+            }
+        }
+
+        // The objects keep their buffers alive
+        BEAST_EXPECT(objects.size() == batch.size());
+        for (int i = 0; i < objects.size(); ++i)
+            BEAST_EXPECT(isSame(batch[i], objects[i]));
+    }
+
+    // Checks that the filter never misses a key it holds
+    void
+    testBloomFilter(std::uint64_t const seedValue)
+    {
+        testcase("bloom filter");
+
+        auto batch = createPredictableBatch(numObjectsToTest, seedValue);
+        auto others = createPredictableBatch(numObjectsToTest, seedValue + 1);
+
+        // About 10 bits per key
+        BloomFilter filter(numObjectsToTest * 10 / 8);
+        for (auto const& object : batch)
+            BEAST_EXPECT(!filter.mayContain(object->getHash()));
+
+        for (auto const& object : batch)
+            filter.insert(object->getHash());
+        for (auto const& object : batch)
+            BEAST_EXPECT(filter.mayContain(object->getHash()));
+
+        int falsePositives = 0;
+        for (auto const& object : others)
+            falsePositives += filter.mayContain(object->getHash());
+        BEAST_EXPECT(falsePositives < numObjectsToTest / 20);
+    }
+
     void
     run() override
     {
@@ -84,6 +149,10 @@ public:
         testBatches(seedValue);
 
         testBlobs(seedValue);
+
+        testSharedBlobs(seedValue);
+
+        testBloomFilter(seedValue);
     }
 };
 
@@ -1119,11 +1119,24 @@ class DatabaseShard_test : public TestBase
 
         using namespace test::jtx;
 
+        // The second pass finalizes with several threads, which must
+        // produce the same files as the first
         for (int i = 0; i < 2; i++)
         {
             beast::temp_dir shardDir;
+            auto makeConfig = [&]() {
+                auto cfg{testConfig(shardDir.path())};
+                if (i == 1)
+                {
+                    cfg->overwrite(
+                        ConfigSection::shardDatabase(),
+                        "finalize_threads",
+                        "4");
+                }
+                return cfg;
+            };
             {
-                Env env{*this, testConfig(shardDir.path())};
+                Env env{*this, makeConfig()};
                 DatabaseShard* db = env.app().getShardStore();
                 BEAST_EXPECT(db);
 
@@ -1144,7 +1157,7 @@ class DatabaseShard_test : public TestBase
                 ripemd160File((path / "nudb.dat").string());
 
             {
-                Env env{*this, testConfig(shardDir.path())};
+                Env env{*this, makeConfig()};
                 DatabaseShard* db = env.app().getShardStore();
                 BEAST_EXPECT(db);
 
@@ -1166,6 +1179,69 @@ class DatabaseShard_test : public TestBase
         }
     }
 
+    void
+    testDeterministicShardCommits()
+    {
+        testcase("Deterministic shard commits");
+
+        using namespace test::jtx;
+
+        // Each object counts its payload and key against the limit,
+        // so every third object fills the memory pool. That is well
+        // below the object limit used for test shards.
+        std::size_t constexpr dataSize = 1000;
+        std::uint64_t constexpr maxMemBytes =
+            3 * (dataSize + NodeObject::keyBytes) - 1;
+        int constexpr objects = 12;
+
+        Serializer finalKey;
+        finalKey.add32(Shard::version);
+        finalKey.add32(ledgersPerShard + 1);
+        finalKey.add32(2 * ledgersPerShard);
+        finalKey.addBitString(uint256(1));
+
+        std::optional<std::string> ripemd160Key;
+        std::optional<std::string> ripemd160Dat;
+        for (int i = 0; i < 2; i++)
+        {
+            beast::temp_dir shardDir;
+            Env env{*this, testConfig(shardDir.path())};
+            boost::filesystem::path const dir{shardDir.path()};
+
+            auto dShard{make_DeterministicShard(
+                env.app(), dir, 1, finalKey, env.journal, maxMemBytes)};
+            if (!BEAST_EXPECT(dShard))
+                return;
+
+            auto const datPath{dShard->getDir() / "nudb.dat"};
+            auto datSize{boost::filesystem::file_size(datPath)};
+            for (int j = 1; j <= objects; ++j)
+            {
+                Blob data(dataSize, static_cast<std::uint8_t>(j));
+                auto const hash{sha512Half(makeSlice(data))};
+                BEAST_EXPECT(dShard->store(NodeObject::createObject(
+                    hotUNKNOWN, std::move(data), hash)));
+
+                // The data file only grows when the pool is committed
+                auto const size{boost::filesystem::file_size(datPath)};
+                BEAST_EXPECT((size != datSize) == (j % 3 == 0));
+                datSize = size;
+            }
+            dShard->close();
+
+            auto const key{
+                ripemd160File((dShard->getDir() / "nudb.key").string())};
+            auto const dat{ripemd160File(datPath.string())};
+            if (ripemd160Key)
+            {
+                BEAST_EXPECT(key == *ripemd160Key);
+                BEAST_EXPECT(dat == *ripemd160Dat);
+            }
+            ripemd160Key = key;
+            ripemd160Dat = dat;
+        }
+    }
+
     void
     testImportNodeStore(std::uint64_t const seedValue)
     {
@@ -1858,6 +1934,7 @@ public:
         testCorruptedDatabase(seedValue());
         testIllegalFinalKey(seedValue());
         testDeterministicShard(seedValue());
+        testDeterministicShardCommits();
         testImportNodeStore(seedValue());
         testImportWithOnlineDelete(seedValue());
         testImportWithHistoricalPaths(seedValue());
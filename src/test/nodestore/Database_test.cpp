@@ -19,18 +19,114 @@
 
 #include <ripple/beast/utility/temp_dir.h>
 #include <ripple/core/DatabaseCon.h>
+#include <ripple/nodestore/Database.h>
 #include <ripple/nodestore/DummyScheduler.h>
 #include <ripple/nodestore/Manager.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/protocol/jss.h>
 #include <test/jtx.h>
 #include <test/jtx/CheckMessageLogs.h>
 #include <test/jtx/envconfig.h>
 #include <test/nodestore/TestBase.h>
 #include <test/unit_test/SuiteJournal.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 namespace ripple {
 
 namespace NodeStore {
 
+// A database whose batch reads take a fixed time and find nothing, to
+// drive the async read threads
+class SlowDatabase : public Database
+{
+    std::chrono::milliseconds const batchTime_;
+
+public:
+    SlowDatabase(
+        Scheduler& scheduler,
+        int readThreads,
+        Section const& config,
+        beast::Journal j,
+        std::chrono::milliseconds batchTime,
+        std::chrono::milliseconds readThreadIdleTimeout)
+        : Database(scheduler, readThreads, config, j, readThreadIdleTimeout)
+        , batchTime_(batchTime)
+    {
+    }
+
+    ~SlowDatabase() override
+    {
+        stop();
+    }
+
+    std::string
+    getName() const override
+    {
+        return "slow";
+    }
+
+    void
+    importDatabase(Database&) override
+    {
+    }
+
+    std::int32_t
+    getWriteLoad() const override
+    {
+        return 0;
+    }
+
+    void
+    store(NodeObjectType, Blob&&, uint256 const&, std::uint32_t) override
+    {
+    }
+
+    bool
+    isSameDB(std::uint32_t, std::uint32_t) override
+    {
+        return true;
+    }
+
+    void
+    sync() override
+    {
+    }
+
+    bool
+    storeLedger(std::shared_ptr<Ledger const> const&) override
+    {
+        return false;
+    }
+
+    void
+    sweep() override
+    {
+    }
+
+private:
+    std::shared_ptr<NodeObject>
+    fetchNodeObject(uint256 const&, std::uint32_t, FetchReport&) override
+    {
+        return {};
+    }
+
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256 const*> const& hashes,
+        std::uint32_t) override
+    {
+        std::this_thread::sleep_for(batchTime_);
+        return std::vector<std::shared_ptr<NodeObject>>(hashes.size());
+    }
+
+    void
+    for_each(std::function<void(std::shared_ptr<NodeObject>)>) override
+    {
+    }
+};
+
 class Database_test : public TestBase
 {
     test::SuiteJournal journal_;
@@ -652,6 +748,140 @@ public:
 
     //--------------------------------------------------------------------------
 
+    void
+    testTieredCache(std::int64_t const seedValue)
+    {
+        testcase("tiered cache");
+
+        DummyScheduler scheduler;
+        beast::temp_dir node_db;
+        beast::temp_dir cache_db;
+
+        auto const batch = createPredictableBatch(numObjectsToTest, seedValue);
+
+        auto counter = [](std::unique_ptr<Database> const& db,
+                          Json::StaticString const& name) {
+            Json::Value obj(Json::objectValue);
+            db->getCountsJson(obj);
+            return std::stoull(obj[name].asString());
+        };
+
+        // The batch holds about 2MB of payloads
+        for (bool const fits : {true, false})
+        {
+            Section params;
+            params.set("type", "nudb");
+            params.set("path", node_db.path());
+            params.set("tiered_cache_path", cache_db.path());
+            params.set("tiered_cache_mb", fits ? "64" : "1");
+
+            std::unique_ptr<Database> db = Manager::instance().make_Database(
+                megabytes(4), scheduler, 2, params, journal_);
+            if (fits)
+                storeBatch(*db, batch);
+
+            // The first reads miss the cache and populate it
+            Batch copy;
+            fetchCopyOfBatch(*db, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual(batch, copy));
+            BEAST_EXPECT(counter(db, jss::tiered_cache_reads_hit) == 0);
+            BEAST_EXPECT(counter(db, jss::tiered_cache_writes) == batch.size());
+
+            fetchCopyOfBatch(*db, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual(batch, copy));
+            if (fits)
+            {
+                // The second reads all hit
+                BEAST_EXPECT(
+                    counter(db, jss::tiered_cache_reads_hit) == batch.size());
+                BEAST_EXPECT(counter(db, jss::tiered_cache_rotations) == 0);
+            }
+            else
+            {
+                // The oldest objects were evicted
+                BEAST_EXPECT(
+                    counter(db, jss::tiered_cache_reads_hit) < batch.size());
+                BEAST_EXPECT(counter(db, jss::tiered_cache_rotations) > 0);
+            }
+        }
+
+        // An invalid capacity is rejected
+        try
+        {
+            Section params;
+            params.set("type", "memory");
+            params.set("path", node_db.path());
+            params.set("tiered_cache_path", cache_db.path());
+            params.set("tiered_cache_mb", "0");
+            std::unique_ptr<Database> db = Manager::instance().make_Database(
+                megabytes(4), scheduler, 2, params, journal_);
+            fail();
+        }
+        catch (std::runtime_error const& e)
+        {
+            BEAST_EXPECT(
+                std::strcmp(
+                    e.what(), "tiered_cache_mb must be greater than 0") == 0);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void
+    testReadThreads()
+    {
+        testcase("adaptive read threads");
+
+        using namespace std::chrono;
+        using namespace std::chrono_literals;
+
+        DummyScheduler scheduler;
+        Section params;
+        params.set("read_threads_max", "4");
+
+        // Each batch takes longer than the queue target, so reads that
+        // arrive while every thread is busy start another one
+        SlowDatabase db(scheduler, 1, params, journal_, 50ms, 100ms);
+
+        auto readThreads = [&] {
+            Json::Value obj(Json::objectValue);
+            db.getCountsJson(obj);
+            return std::stoi(obj[jss::node_read_threads].asString());
+        };
+        BEAST_EXPECT(readThreads() == 1);
+
+        std::atomic<std::size_t> done{0};
+        std::size_t queued = 0;
+        int most = 0;
+        for (auto const deadline = steady_clock::now() + 5s;
+             steady_clock::now() < deadline;)
+        {
+            db.asyncFetch(
+                sha512Half(queued++),
+                0,
+                [&](std::shared_ptr<NodeObject> const&) { ++done; });
+            most = std::max(most, readThreads());
+            BEAST_EXPECT(most <= 4);
+            if (most == 4 && queued >= 200)
+                break;
+            std::this_thread::sleep_for(1ms);
+        }
+        BEAST_EXPECT(most > 1);
+        BEAST_EXPECT(most <= 4);
+
+        // Every read completes, then the idle threads exit
+        auto const deadline = steady_clock::now() + 10s;
+        while ((done < queued || readThreads() > 1) &&
+               steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(10ms);
+        }
+        BEAST_EXPECT(done == queued);
+        BEAST_EXPECT(readThreads() == 1);
+    }
+
+    //--------------------------------------------------------------------------
+
     void
     run() override
     {
@@ -670,6 +900,10 @@ public:
 #endif
         }
 
+        testTieredCache(seedValue);
+
+        testReadThreads();
+
         // Import tests
         {
             testImport("nudb", "nudb", seedValue);
@@ -23,16 +23,25 @@
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/utility/temp_dir.h>
 #include <ripple/beast/xor_shift_engine.h>
+#include <ripple/json/json_value.h>
+#include <ripple/nodestore/CodecDictionary.h>
 #include <ripple/nodestore/DummyScheduler.h>
 #include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/EncodedBlob.h>
+#include <ripple/nodestore/impl/codec.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/STLedgerEntry.h>
 #include <ripple/unity/rocksdb.h>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
 #include <atomic>
 #include <beast/unit_test/thread.hpp>
 #include <chrono>
+#include <cstring>
 #include <iterator>
 #include <limits>
 #include <map>
+#include <nudb/detail/buffer.hpp>
 #include <random>
 #include <sstream>
 #include <stdexcept>
@@ -138,6 +147,39 @@ public:
     }
 };
 
+// Returns the n-th account root, encoded as the codec sees it. Unlike
+// the random objects of Sequence these have the structure of real
+// ledger entries, which is what a compression dictionary learns.
+static Blob
+encodedAccountRoot(std::size_t n)
+{
+    beast::xor_shift_engine gen(n + 1);
+    AccountID id;
+    rngcpy(id.data(), id.size(), gen);
+    uint256 txID;
+    rngcpy(txID.data(), txID.size(), gen);
+
+    SLE sle(keylet::account(id));
+    sle.setAccountID(sfAccount, id);
+    sle.setFieldAmount(sfBalance, STAmount(gen() % 100000000000000ull));
+    sle.setFieldU32(sfFlags, 0);
+    sle.setFieldU32(sfOwnerCount, gen() % 32);
+    sle.setFieldU32(sfSequence, gen() % 70000000);
+    sle.setFieldH256(sfPreviousTxnID, txID);
+    sle.setFieldU32(sfPreviousTxnLgrSeq, gen() % 70000000);
+
+    Serializer s;
+    s.add32(HashPrefix::leafNode);
+    sle.add(s);
+    s.addBitString(sle.key());
+
+    EncodedBlob e;
+    e.prepare(NodeObject::createObject(
+        hotACCOUNT_NODE, std::move(s.modData()), sle.key()));
+    auto const p = static_cast<std::uint8_t const*>(e.getData());
+    return Blob(p, p + e.getSize());
+}
+
 //----------------------------------------------------------------------------------
 
 class Timing_test : public beast::unit_test::suite
@@ -145,7 +187,10 @@ class Timing_test : public beast::unit_test::suite
 public:
     enum {
         // percent of fetches for missing nodes
-        missingNodePercent = 20
+        missingNodePercent = 20,
+
+        // number of keys requested by each fetchBatch call
+        fetchBatchSize = 256
     };
 
     std::size_t const default_repeat = 3;
@@ -392,6 +437,89 @@ public:
         backend->close();
     }
 
+    // Fetch existing keys in batches
+    void
+    do_fetch_batch(
+        Section const& config,
+        Params const& params,
+        beast::Journal journal)
+    {
+        DummyScheduler scheduler;
+        auto backend = make_Backend(config, scheduler, journal);
+        BEAST_EXPECT(backend != nullptr);
+        backend->open();
+
+        class Body
+        {
+        private:
+            suite& suite_;
+            Backend& backend_;
+            Sequence seq1_;
+            beast::xor_shift_engine gen_;
+            std::uniform_int_distribution<std::size_t> dist_;
+
+        public:
+            Body(
+                std::size_t id,
+                suite& s,
+                Params const& params,
+                Backend& backend)
+                : suite_(s)
+                , backend_(backend)
+                , seq1_(1)
+                , gen_(id + 1)
+                , dist_(0, params.items - 1)
+            {
+            }
+
+            void
+            operator()(std::size_t i)
+            {
+                try
+                {
+                    Batch objs;
+                    objs.reserve(fetchBatchSize);
+                    std::vector<uint256 const*> hashes;
+                    hashes.reserve(fetchBatchSize);
+                    for (std::size_t n = 0; n < fetchBatchSize; ++n)
+                    {
+                        objs.emplace_back(seq1_.obj(dist_(gen_)));
+                        hashes.push_back(&objs.back()->getHash());
+                    }
+
+                    auto const [results, status] = backend_.fetchBatch(hashes);
+                    suite_.expect(status == ok);
+                    if (!suite_.expect(results.size() == objs.size()))
+                        return;
+                    for (std::size_t n = 0; n < objs.size(); ++n)
+                        suite_.expect(
+                            results[n] && isSame(results[n], objs[n]));
+                }
+                catch (std::exception const& e)
+                {
+                    suite_.fail(e.what());
+                }
+            }
+        };
+        try
+        {
+            parallel_for_id<Body>(
+                (params.items + fetchBatchSize - 1) / fetchBatchSize,
+                params.threads,
+                std::ref(*this),
+                std::ref(params),
+                std::ref(*backend));
+        }
+        catch (std::exception const&)
+        {
+#if NODESTORE_TIMING_DO_VERIFY
+            backend->verify();
+#endif
+            Rethrow();
+        }
+        backend->close();
+    }
+
     // Perform lookups of non-existent keys
     void
     do_missing(
@@ -669,6 +797,72 @@ public:
 
     //--------------------------------------------------------------------------
 
+    // Compare the compression ratio and decode speed of lz4 against
+    // zstd with a dictionary trained on a separate set of objects.
+    void
+    do_codecs(std::size_t items)
+    {
+        using std::setw;
+        std::vector<Blob> samples;
+        samples.reserve(items);
+        for (std::size_t i = 0; i < items; ++i)
+            samples.push_back(encodedAccountRoot(i));
+        CodecDictionary const dict(
+            CodecDictionary::train(samples, CodecDictionary::defaultCapacity));
+
+        std::vector<Blob> objects;
+        objects.reserve(items);
+        std::size_t raw = 0;
+        for (std::size_t i = 0; i < items; ++i)
+        {
+            objects.push_back(encodedAccountRoot(items + i));
+            raw += objects.back().size();
+        }
+
+        log << std::left << setw(10) << "Codec" << std::right << " "
+            << setw(8) << "Ratio"
+            << " " << setw(8) << "Decode" << std::endl;
+
+        for (auto const d : {static_cast<CodecDictionary const*>(nullptr),
+                             &dict})
+        {
+            std::vector<Blob> encoded;
+            encoded.reserve(objects.size());
+            std::size_t stored = 0;
+            nudb::detail::buffer bf;
+            for (auto const& o : objects)
+            {
+                auto const r = nodeobject_compress(o.data(), o.size(), bf, d);
+                auto const p = static_cast<std::uint8_t const*>(r.first);
+                encoded.emplace_back(p, p + r.second);
+                stored += r.second;
+            }
+
+            auto const start = clock_type::now();
+            for (std::size_t i = 0; i < encoded.size(); ++i)
+            {
+                auto const r = nodeobject_decompress(
+                    encoded[i].data(), encoded[i].size(), bf, d);
+                if (!BEAST_EXPECT(
+                        r.second == objects[i].size() &&
+                        std::memcmp(r.first, objects[i].data(), r.second) ==
+                            0))
+                    break;
+            }
+            auto const elapsed = std::chrono::duration_cast<duration_type>(
+                clock_type::now() - start);
+
+            std::stringstream ss;
+            ss << std::left << setw(10) << (d ? "zstd+dict" : "lz4")
+               << std::right << " " << setw(8) << std::fixed
+               << std::setprecision(3) << (double(raw) / stored) << " "
+               << setw(8) << to_string(elapsed);
+            log << ss.str() << std::endl;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
     using test_func =
         void (Timing_test::*)(Section const&, Params const&, beast::Journal);
     using test_list = std::vector<std::pair<std::string, test_func>>;
@@ -733,10 +927,97 @@ public:
         }
     }
 
+    // Write amplification reported by the backend after a bulk insert,
+    // and the 99th percentile latency of single fetches that follow.
+    void
+    do_profiles(std::vector<std::string> const& config_strings)
+    {
+        using std::setw;
+        using namespace std::chrono;
+
+        test::SuiteJournal journal("Timing_test", *this);
+        log << std::left << setw(10) << "Backend" << std::right << " "
+            << setw(8) << "WriteAmp"
+            << " " << setw(8) << "FetchP99" << std::endl;
+
+        for (auto const& config_string : config_strings)
+        {
+            beast::temp_dir tempDir;
+            Section config = parse(config_string);
+            config.set("path", tempDir.path());
+            // Small files and memtables, so the data lands in several
+            // files that compaction then has to merge, as it would with
+            // a database much larger than the memtable
+            config.set("file_size_mb", "1");
+
+            DummyScheduler scheduler;
+            auto backend = make_Backend(config, scheduler, journal);
+            BEAST_EXPECT(backend != nullptr);
+            backend->open();
+
+            Sequence seq(1);
+            Batch batch;
+            for (std::size_t i = 0; i < default_items; i += fetchBatchSize)
+            {
+                seq.batch(
+                    i, batch, std::min<std::size_t>(
+                        fetchBatchSize, default_items - i));
+                backend->storeBatch(batch);
+            }
+
+            // Sample the counts once background compaction has settled
+            Json::Value counts(Json::objectValue);
+            auto const deadline = clock_type::now() + 60s;
+            for (;;)
+            {
+                counts = Json::Value(Json::objectValue);
+                backend->getCountsJson(counts);
+                auto const busy = [&](char const* key) {
+                    return counts.get(key, "0").asString() != "0";
+                };
+                if ((!busy("rocksdb_compaction_pending") &&
+                     !busy("rocksdb_running_compactions")) ||
+                    clock_type::now() > deadline)
+                    break;
+                std::this_thread::sleep_for(10ms);
+            }
+
+            beast::xor_shift_engine gen(1);
+            std::uniform_int_distribution<std::size_t> dist(
+                0, default_items - 1);
+            std::vector<microseconds> latency;
+            latency.reserve(default_items);
+            for (std::size_t i = 0; i < default_items; ++i)
+            {
+                auto const obj = seq.obj(dist(gen));
+                std::shared_ptr<NodeObject> result;
+                auto const start = clock_type::now();
+                backend->fetch(obj->getHash().data(), &result);
+                latency.push_back(duration_cast<microseconds>(
+                    clock_type::now() - start));
+                BEAST_EXPECT(result && isSame(result, obj));
+            }
+            backend->close();
+
+            auto const p99 = latency.begin() + latency.size() * 99 / 100;
+            std::nth_element(latency.begin(), p99, latency.end());
+
+            std::stringstream ss;
+            ss << std::left << setw(10) << get(config, "type", std::string())
+               << std::right << " " << setw(8)
+               << counts.get("rocksdb_write_amplification", "-").asString()
+               << " " << setw(6) << p99->count() << "us   "
+               << to_string(config);
+            log << ss.str() << std::endl;
+        }
+    }
+
     void
     run() override
     {
-        testcase("Timing", beast::unit_test::abort_on_fail);
+        testcase("Codec");
+        log << default_items << " Objects" << std::endl;
+        do_codecs(default_items);
 
         /*  Parameters:
 
@@ -746,9 +1027,12 @@ public:
         */
         std::string default_args =
             "type=nudb"
+            ";type=nudb,batch_read_threads=4"
 #if RIPPLE_ROCKSDB_AVAILABLE
             ";type=rocksdb,open_files=2000,filter_bits=12,cache_mb=256,"
             "file_size_mb=8,file_size_mult=2"
+            ";type=rocksdb,profile=write_once,online_delete=256,"
+            "open_files=2000,filter_bits=12,cache_mb=256,file_size_mb=8"
 #endif
 #if 0
             ";type=memory|path=NodeStore"
@@ -758,6 +1042,7 @@ public:
         test_list const tests = {
             {"Insert", &Timing_test::do_insert},
             {"Fetch", &Timing_test::do_fetch},
+            {"Batch", &Timing_test::do_fetch_batch},
             {"Missing", &Timing_test::do_missing},
             {"Mixed", &Timing_test::do_mixed},
             {"Work", &Timing_test::do_work}};
@@ -771,6 +1056,10 @@ public:
             else
                 ++iter;
 
+        testcase("Profiles");
+        do_profiles(config_strings);
+
+        testcase("Timing", beast::unit_test::abort_on_fail);
         do_tests(1, tests, config_strings);
         do_tests(4, tests, config_strings);
         do_tests(8, tests, config_strings);
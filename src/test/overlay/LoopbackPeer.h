@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_TEST_OVERLAY_LOOPBACKPEER_H_INCLUDED
+#define RIPPLE_TEST_OVERLAY_LOOPBACKPEER_H_INCLUDED
+
+#include <ripple/app/main/Application.h>
+#include <ripple/basics/make_SSLContext.h>
+#include <ripple/beast/net/IPAddressConversion.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/Message.h>
+#include <ripple/overlay/impl/OverlayImpl.h>
+#include <ripple/overlay/impl/PeerImp.h>
+#include <ripple/peerfinder/PeerfinderManager.h>
+#include <ripple/protocol/SecretKey.h>
+
+#include <boost/asio/ssl.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/ssl/ssl_stream.hpp>
+
+#include <array>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+/** An active PeerImp whose connection ends at a plain SSL socket.
+
+    The test plays the remote server: it reads what the peer sends and
+    writes messages for the peer to receive, without a handshake.
+*/
+class LoopbackPeer
+{
+    using socket_type = boost::asio::ip::tcp::socket;
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+    using stream_type = boost::beast::ssl_stream<boost::beast::tcp_stream>;
+
+    beast::unit_test::suite& suite_;
+    std::shared_ptr<boost::asio::ssl::context> context_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    socket_type remoteSocket_;
+    boost::asio::ssl::stream<socket_type&> remote_;
+
+public:
+    /** The peer, or nullptr if the overlay gave it no slot. */
+    std::shared_ptr<PeerImp> peer;
+
+    LoopbackPeer(beast::unit_test::suite& suite, Application& app)
+        : suite_(suite)
+        , context_(make_SSLContext(""))
+        , acceptor_(
+              app.getIOService(),
+              endpoint_type(boost::asio::ip::address_v4::loopback(), 0))
+        , remoteSocket_(app.getIOService())
+        , remote_(remoteSocket_, *context_)
+    {
+        auto& overlay = dynamic_cast<OverlayImpl&>(app.overlay());
+
+        // Connect the peer's stream to a socket on the loopback interface
+        auto stream = std::make_unique<stream_type>(
+            socket_type(
+                std::forward<boost::asio::io_service&>(app.getIOService())),
+            *context_);
+        stream->next_layer().socket().connect(acceptor_.local_endpoint());
+        acceptor_.accept(remoteSocket_);
+        auto handshake = std::async(std::launch::async, [this] {
+            remote_.handshake(boost::asio::ssl::stream_base::server);
+        });
+        stream->handshake(boost::asio::ssl::stream_base::client);
+        handshake.get();
+
+        auto const remoteEndpoint =
+            beast::IPAddressConversion::from_asio(acceptor_.local_endpoint());
+        auto slot = overlay.peerFinder().new_outbound_slot(remoteEndpoint);
+        if (!slot)
+            return;
+
+        peer = std::make_shared<PeerImp>(
+            app,
+            std::move(stream),
+            boost::asio::const_buffer(),
+            std::move(slot),
+            http_response_type{},
+            overlay.resourceManager().newOutboundEndpoint(remoteEndpoint),
+            randomKeyPair(KeyType::secp256k1).first,
+            make_protocol(2, 2),
+            1000,
+            overlay);
+        overlay.add_active(peer);
+    }
+
+    LoopbackPeer(LoopbackPeer const&) = delete;
+    LoopbackPeer&
+    operator=(LoopbackPeer const&) = delete;
+
+    ~LoopbackPeer()
+    {
+        if (peer)
+            stop();
+    }
+
+    /** Read one uncompressed message sent by the peer.
+
+        @return The message type and its payload.
+    */
+    std::pair<std::uint16_t, std::string>
+    read()
+    {
+        std::array<std::uint8_t, 6> header;
+        boost::asio::read(remote_, boost::asio::buffer(header));
+
+        // The top bits of the size are flags, clear for an
+        // uncompressed message
+        suite_.expect((header[0] & 0xFC) == 0, "uncompressed message");
+        std::size_t const size = (std::size_t{header[0]} << 24) +
+            (std::size_t{header[1]} << 16) + (std::size_t{header[2]} << 8) +
+            header[3];
+        std::uint16_t const type = (header[4] << 8) + header[5];
+
+        std::string payload(size, '\0');
+        boost::asio::read(remote_, boost::asio::buffer(payload));
+        return {type, std::move(payload)};
+    }
+
+    /** Write a message for the peer to receive. */
+    void
+    write(Message& message)
+    {
+        boost::asio::write(
+            remote_,
+            boost::asio::buffer(
+                message.getBuffer(compression::Compressed::Off)));
+    }
+
+    /** Stop the peer and wait for its pending handlers to finish, so
+        that it is gone before the overlay is.
+    */
+    void
+    stop()
+    {
+        using namespace std::chrono_literals;
+
+        std::weak_ptr<PeerImp> weak = peer;
+        peer->stop();
+        peer.reset();
+        for (auto const deadline = std::chrono::steady_clock::now() + 10s;
+             !weak.expired() && std::chrono::steady_clock::now() < deadline;)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+        suite_.expect(weak.expired(), "peer destroyed");
+    }
+};
+
+}  // namespace test
+}  // namespace ripple
+
+#endif
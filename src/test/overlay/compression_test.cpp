@@ -39,6 +39,8 @@
 #include <boost/beast/core/multi_buffer.hpp>
 #include <boost/endian/conversion.hpp>
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <ripple.pb.h>
 #include <test/jtx/Account.h>
 #include <test/jtx/Env.h>
@@ -74,9 +76,19 @@ class compression_test : public beast::unit_test::suite
     using Compressed = compression::Compressed;
     using Algorithm = compression::Algorithm;
 
+    // Log the compression ratio and throughput, and include the
+    // largest messages
+    bool const bench_;
+
 public:
-    compression_test()
+    explicit compression_test(bool bench = false) : bench_(bench)
+    {
+    }
+
+    static std::string
+    toString(Algorithm algorithm)
     {
+        return algorithm == Algorithm::ZSTD ? "zstd" : "lz4";
     }
 
     template <typename T>
@@ -87,11 +99,28 @@ public:
         uint16_t nbuffers,
         std::string msg)
     {
-        testcase("Compress/Decompress: " + msg);
+        for (auto const algorithm : {Algorithm::LZ4, Algorithm::ZSTD})
+            doTest(proto, mt, nbuffers, msg, algorithm);
+    }
+
+    template <typename T>
+    void
+    doTest(
+        std::shared_ptr<T> proto,
+        protocol::MessageType mt,
+        uint16_t nbuffers,
+        std::string msg,
+        Algorithm algorithm)
+    {
+        using namespace std::chrono;
+
+        testcase("Compress/Decompress: " + msg + " " + toString(algorithm));
 
         Message m(*proto, mt);
 
-        auto& buffer = m.getBuffer(Compressed::On);
+        auto const compressStart = steady_clock::now();
+        auto& buffer = m.getBuffer(algorithm);
+        auto const compressTime = steady_clock::now() - compressStart;
 
         boost::beast::multi_buffer buffers;
 
@@ -116,6 +145,9 @@ public:
         if (!header || header->algorithm == Algorithm::None)
             return;
 
+        BEAST_EXPECT(header->algorithm == algorithm);
+        BEAST_EXPECT(header->message_type == mt);
+
         std::vector<std::uint8_t> decompressed;
         decompressed.resize(header->uncompressed_size);
 
@@ -125,21 +157,40 @@ public:
         ZeroCopyInputStream stream(buffers.data());
         stream.Skip(header->header_size);
 
+        auto const decompressStart = steady_clock::now();
         auto decompressedSize = ripple::compression::decompress(
             stream,
             header->payload_wire_size,
             decompressed.data(),
-            header->uncompressed_size);
+            header->uncompressed_size,
+            header->algorithm);
+        auto const decompressTime = steady_clock::now() - decompressStart;
         BEAST_EXPECT(decompressedSize == header->uncompressed_size);
         auto const proto1 = std::make_shared<T>();
 
         BEAST_EXPECT(
             proto1->ParseFromArray(decompressed.data(), decompressedSize));
-        auto uncompressed = m.getBuffer(Compressed::Off);
+        auto uncompressed = m.getBuffer(Algorithm::None);
         BEAST_EXPECT(std::equal(
             uncompressed.begin() + ripple::compression::headerBytes,
             uncompressed.end(),
             decompressed.begin()));
+
+        if (!bench_)
+            return;
+
+        // Megabytes of uncompressed data per second
+        auto const throughput = [&](auto elapsed) {
+            auto const us = duration_cast<microseconds>(elapsed).count();
+            return us == 0 ? 0.0 : double(uncompressed.size()) / us;
+        };
+        log << msg << " " << toString(algorithm) << ": "
+            << uncompressed.size() << " -> " << buffer.size()
+            << " bytes, ratio "
+            << double(uncompressed.size()) / buffer.size()
+            << ", compress " << throughput(compressTime)
+            << " MB/s, decompress " << throughput(decompressTime) << " MB/s"
+            << std::endl;
     }
 
     std::shared_ptr<protocol::TMManifests>
@@ -428,18 +479,21 @@ public:
             protocol::mtLEDGER_DATA,
             50,
             "TMLedgerData10000");
-        // 12MB
-        doTest(
-            buildLedgerData(100000, *logs),
-            protocol::mtLEDGER_DATA,
-            100,
-            "TMLedgerData100000");
-        // 61MB
-        doTest(
-            buildLedgerData(500000, *logs),
-            protocol::mtLEDGER_DATA,
-            100,
-            "TMLedgerData500000");
+        if (bench_)
+        {
+            // 12MB
+            doTest(
+                buildLedgerData(100000, *logs),
+                protocol::mtLEDGER_DATA,
+                100,
+                "TMLedgerData100000");
+            // 61MB
+            doTest(
+                buildLedgerData(500000, *logs),
+                protocol::mtLEDGER_DATA,
+                100,
+                "TMLedgerData500000");
+        }
         // 7.7KB
         doTest(
             buildGetObjectByHash(),
@@ -498,9 +552,11 @@ public:
             auto const peerEnabled = inboundEnable && outboundEnable;
             // inbound is enabled if the request's header has the feature
             // enabled and the peer's configuration is enabled
-            auto const inboundEnabled = peerFeatureEnabled(
-                http_request, FEATURE_COMPR, "lz4", inboundEnable);
-            BEAST_EXPECT(!(peerEnabled ^ inboundEnabled));
+            auto const inboundAlgorithm =
+                peerCompressionAlgorithm(http_request, inboundEnable);
+            BEAST_EXPECT(
+                inboundAlgorithm ==
+                (peerEnabled ? Algorithm::ZSTD : Algorithm::None));
 
             env.reset();
             env = getEnv(inboundEnable);
@@ -515,14 +571,72 @@ public:
                 env->app());
             // outbound is enabled if the response's header has the feature
             // enabled and the peer's configuration is enabled
-            auto const outboundEnabled = peerFeatureEnabled(
-                http_resp, FEATURE_COMPR, "lz4", outboundEnable);
-            BEAST_EXPECT(!(peerEnabled ^ outboundEnabled));
+            auto const outboundAlgorithm =
+                peerCompressionAlgorithm(http_resp, outboundEnable);
+            BEAST_EXPECT(outboundAlgorithm == inboundAlgorithm);
         };
         handshake(1, 1);
         handshake(1, 0);
         handshake(0, 1);
         handshake(0, 0);
+
+        // A peer that only offers lz4 gets lz4
+        http_request_type lz4Request;
+        lz4Request.insert("X-Protocol-Ctl", "compr=lz4");
+        BEAST_EXPECT(
+            peerCompressionAlgorithm(lz4Request, true) == Algorithm::LZ4);
+        BEAST_EXPECT(
+            makeFeaturesResponseHeader(lz4Request, true, false, false) ==
+            "compr=lz4;");
+
+        // zstd is offered with the version of its frame format, and an
+        // unversioned offer is not taken as that version
+        BEAST_EXPECT(
+            makeFeaturesRequestHeader(true, false, false) ==
+            "compr=zstd1,lz4;");
+        http_request_type zstdRequest;
+        zstdRequest.insert("X-Protocol-Ctl", "compr=zstd,lz4");
+        BEAST_EXPECT(
+            peerCompressionAlgorithm(zstdRequest, true) == Algorithm::LZ4);
+    }
+
+    void
+    testAsync()
+    {
+        testcase("Compress on the job queue");
+
+        auto logs = std::make_unique<Logs>(beast::severities::kInfo);
+        Env env(*this);
+        auto& jobQueue = env.app().getJobQueue();
+
+        // 122 KB, large enough to be compressed off the caller
+        auto const m = std::make_shared<Message>(
+            *buildLedgerData(1000, *logs), protocol::mtLEDGER_DATA);
+
+        auto wait = [&](std::promise<void>& ready) {
+            return ready.get_future().wait_for(std::chrono::seconds(10)) ==
+                std::future_status::ready;
+        };
+        std::promise<void> ready1;
+        BEAST_EXPECT(!m->compressAsync(
+            Algorithm::ZSTD, jobQueue, [&ready1] { ready1.set_value(); }));
+        // A second peer waits for the same compression, unless it is done
+        std::promise<void> ready2;
+        bool const done2 = m->compressAsync(
+            Algorithm::ZSTD, jobQueue, [&ready2] { ready2.set_value(); });
+        BEAST_EXPECT(wait(ready1));
+        BEAST_EXPECT(done2 || wait(ready2));
+
+        auto const& buffer = m->getBuffer(Algorithm::ZSTD);
+        BEAST_EXPECT(buffer.size() < m->getBufferSize());
+        BEAST_EXPECT(
+            m->compressAsync(Algorithm::ZSTD, jobQueue, [this] { fail(); }));
+
+        // Small messages are compressed by the caller
+        auto const small = std::make_shared<Message>(
+            *buildEndpoints(10), protocol::mtENDPOINTS);
+        BEAST_EXPECT(small->compressAsync(
+            Algorithm::ZSTD, jobQueue, [this] { fail(); }));
     }
 
     void
@@ -530,10 +644,26 @@ public:
     {
         testProtocol();
         testHandshake();
+        testAsync();
+    }
+};
+
+class compression_bench_test : public compression_test
+{
+public:
+    compression_bench_test() : compression_test(true)
+    {
+    }
+
+    void
+    run() override
+    {
+        testProtocol();
     }
 };
 
-BEAST_DEFINE_TESTSUITE_MANUAL(compression, ripple_data, ripple);
+BEAST_DEFINE_TESTSUITE(compression, ripple_data, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(compression_bench, ripple_data, ripple);
 
 }  // namespace test
 }  // namespace ripple
@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/Message.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx/Env.h>
+#include <test/overlay/LoopbackPeer.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+/** Checks that the messages queued on a peer arrive whole and in order,
+    whether they are written one at a time or gathered into larger writes.
+*/
+class send_queue_test : public beast::unit_test::suite
+{
+    void
+    testSend(std::chrono::microseconds cork)
+    {
+        testcase(
+            cork.count() ? "send queue with send_cork" : "send queue");
+
+        using namespace jtx;
+        using namespace std::chrono_literals;
+
+        Env env{*this, envconfig([&](std::unique_ptr<Config> cfg) {
+                    cfg->section("overlay").set(
+                        "send_cork", std::to_string(cork.count()));
+                    return cfg;
+                })};
+
+        std::uint32_t constexpr count = 64;
+        std::vector<std::shared_ptr<Message>> messages;
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            protocol::TMPing ping;
+            ping.set_type(protocol::TMPing::ptPING);
+            ping.set_seq(i);
+            messages.push_back(
+                std::make_shared<Message>(ping, protocol::mtPING));
+        }
+
+        LoopbackPeer loopback(*this, env.app());
+        auto const& peer = loopback.peer;
+        if (!BEAST_EXPECT(peer))
+            return;
+
+        // Queue the messages from this thread, so that they pile up
+        // on the peer's strand while earlier ones are written
+        for (auto const& m : messages)
+            peer->send(m);
+
+        // The peer sends messages of its own as well, so skip any that
+        // are not the test's pings
+        std::uint64_t received = 0;
+        for (std::uint32_t i = 0; i < count; ++received)
+        {
+            auto const [type, payload] = loopback.read();
+            if (type != protocol::mtPING)
+                continue;
+            protocol::TMPing ping;
+            BEAST_EXPECT(ping.ParseFromString(payload));
+            BEAST_EXPECT(ping.seq() == i++);
+        }
+
+        // The counters are updated when each write completes
+        auto metric = [&](Json::StaticString const& name) {
+            return std::stoull(peer->json()[jss::metrics][name].asString());
+        };
+        for (auto const deadline = std::chrono::steady_clock::now() + 10s;
+             metric(jss::total_msgs_sent) < received &&
+             std::chrono::steady_clock::now() < deadline;)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+
+        // The peer may have sent more since, but every message that was
+        // read is counted, and each write carries at least one message
+        auto const writes = metric(jss::total_writes);
+        auto const sent = metric(jss::total_msgs_sent);
+        BEAST_EXPECT(sent >= received);
+        BEAST_EXPECT(writes >= 1 && writes <= sent);
+
+        // Messages queued while the first one was held went out together
+        if (cork.count())
+            BEAST_EXPECT(writes < sent);
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono_literals;
+        testSend(0us);
+        testSend(10ms);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(send_queue, ripple_data, ripple);
+
+}  // namespace test
+}  // namespace ripple
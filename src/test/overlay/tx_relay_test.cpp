@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/misc/HashRouter.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/Message.h>
+#include <ripple/overlay/impl/OverlayImpl.h>
+#include <test/jtx.h>
+#include <test/overlay/LoopbackPeer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+/** Relays transactions from a connected peer, and checks that the ones
+    that pass the checks reach the open ledger and the rest are rejected.
+*/
+class tx_relay_test : public beast::unit_test::suite
+{
+    void
+    testRelay()
+    {
+        testcase("Relay good, badly signed and expired transactions");
+
+        using namespace jtx;
+        using namespace std::chrono_literals;
+
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        Account const dan{"dan"};
+        env.fund(XRP(10000), alice, bob, carol, dan);
+        for (int i = 0; i < 3; ++i)
+            env.close();
+
+        LoopbackPeer loopback(*this, env.app());
+        if (!BEAST_EXPECT(loopback.peer))
+            return;
+
+        // Each transaction is from its own account, so that the good ones
+        // can be applied in any order
+        std::vector<std::shared_ptr<STTx const>> good;
+        good.push_back(env.jt(pay(alice, bob, XRP(100))).stx);
+        good.push_back(env.jt(pay(bob, alice, XRP(100))).stx);
+
+        // Parse the tampered transaction again so that its ID matches
+        // the one the peer computes
+        auto const bad = [&] {
+            STTx tx{*env.jt(pay(carol, alice, XRP(100))).stx};
+            tx.setFieldVL(sfTxnSignature, Blob(70, 0x01));
+            Serializer s;
+            tx.add(s);
+            SerialIter sit(s.slice());
+            return std::make_shared<STTx const>(sit);
+        }();
+
+        auto const validLedgerIndex =
+            env.app().getLedgerMaster().getValidLedgerIndex();
+        BEAST_EXPECT(validLedgerIndex > 1);
+        auto const expired = env.jt(
+            pay(dan, alice, XRP(100)), last_ledger_seq(validLedgerIndex - 1))
+                                 .stx;
+
+        auto relay = [&](STTx const& tx) {
+            Serializer s;
+            tx.add(s);
+            protocol::TMTransaction m;
+            m.set_rawtransaction(s.data(), s.size());
+            m.set_status(protocol::tsNEW);
+            Message message(m, protocol::mtTRANSACTION);
+            loopback.write(message);
+        };
+        for (auto const& tx : good)
+            relay(*tx);
+        relay(*bad);
+        relay(*expired);
+
+        auto applied = [&](STTx const& tx) {
+            return env.current()->txExists(tx.getTransactionID());
+        };
+        auto rejected = [&](STTx const& tx) {
+            return (env.app().getHashRouter().getFlags(
+                        tx.getTransactionID()) &
+                    SF_BAD) != 0;
+        };
+        auto done = [&] {
+            return std::all_of(
+                       good.begin(),
+                       good.end(),
+                       [&](auto const& tx) { return applied(*tx); }) &&
+                rejected(*bad) && rejected(*expired);
+        };
+        for (auto const deadline = std::chrono::steady_clock::now() + 10s;
+             !done() && std::chrono::steady_clock::now() < deadline;)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+
+        for (auto const& tx : good)
+        {
+            BEAST_EXPECT(applied(*tx));
+            BEAST_EXPECT(!rejected(*tx));
+        }
+        BEAST_EXPECT(rejected(*bad));
+        BEAST_EXPECT(!applied(*bad));
+        BEAST_EXPECT(rejected(*expired));
+        BEAST_EXPECT(!applied(*expired));
+        auto& overlay = dynamic_cast<OverlayImpl&>(env.app().overlay());
+        BEAST_EXPECT(overlay.txVerifier().size() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testRelay();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(tx_relay, ripple_data, ripple);
+
+}  // namespace test
+}  // namespace ripple
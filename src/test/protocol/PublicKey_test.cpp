@@ -453,12 +453,64 @@ public:
         BEAST_EXPECT(pk1 == pk3);
     }
 
+    void
+    testVerifyBatch()
+    {
+        testcase("Batch verification");
+
+        std::string const message = "The batch is checked as a whole";
+        std::vector<std::pair<PublicKey, Buffer>> sigs;
+        for (auto const type : {KeyType::ed25519, KeyType::secp256k1})
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                auto const [pk, sk] = randomKeyPair(type);
+                sigs.emplace_back(pk, sign(pk, sk, makeSlice(message)));
+            }
+        }
+
+        // Corrupt one signature of each type
+        Buffer bad0(sigs[1].second.data(), sigs[1].second.size());
+        bad0.data()[10] ^= 0x01;
+        Buffer bad1(sigs[6].second.data(), sigs[6].second.size());
+        bad1.data()[10] ^= 0x01;
+        std::string const other = "Some other message";
+
+        std::vector<SignatureCheck> checks;
+        for (auto const& [pk, sig] : sigs)
+            checks.push_back({pk, makeSlice(message), sig});
+        checks[1].signature = bad0;
+        checks[6].signature = bad1;
+        // The signature of another message
+        checks[3].message = makeSlice(other);
+        // Signed with a different key
+        checks.push_back(
+            {sigs[0].first, makeSlice(message), sigs[2].second});
+
+        auto const results = verifyBatch(checks);
+        BEAST_EXPECT(results.size() == checks.size());
+        for (std::size_t i = 0; i < checks.size(); ++i)
+        {
+            auto const expected = !(i == 1 || i == 3 || i == 6 || i == 8);
+            BEAST_EXPECT(results[i] == expected);
+            BEAST_EXPECT(
+                results[i] ==
+                verify(
+                    checks[i].publicKey,
+                    checks[i].message,
+                    checks[i].signature));
+        }
+
+        BEAST_EXPECT(verifyBatch({}).empty());
+    }
+
     void
     run() override
     {
         testBase58();
         testCanonical();
         testMiscOperations();
+        testVerifyBatch();
     }
 };
 
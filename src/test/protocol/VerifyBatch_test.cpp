@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/PublicKey.h>
+#include <ripple/protocol/SecretKey.h>
+#include <chrono>
+#include <ed25519.h>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+// Measures the cost of checking a signature at several batch sizes
+class VerifyBatch_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    // Signatures checked for each measurement, whatever the batch size
+    static constexpr std::size_t signatures = 4096;
+
+    struct Signed
+    {
+        PublicKey publicKey;
+        std::string message;
+        Buffer signature;
+    };
+
+    static std::vector<Signed>
+    makeSigned(KeyType type, std::size_t count)
+    {
+        std::vector<Signed> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto const [pk, sk] = randomKeyPair(type);
+            // About the size of the signing data of a payment
+            auto message = std::string(150, 'x') + std::to_string(i);
+            auto sig = sign(pk, sk, makeSlice(message));
+            result.push_back({pk, std::move(message), std::move(sig)});
+        }
+        return result;
+    }
+
+    void
+    report(
+        std::string const& name,
+        std::size_t batchSize,
+        clock_type::duration elapsed)
+    {
+        using namespace std::chrono;
+        auto const ns = duration_cast<nanoseconds>(elapsed).count();
+        log << std::setw(24) << std::left << name << std::setw(6)
+            << std::right << batchSize << std::setw(10) << ns / signatures
+            << " ns/signature" << std::endl;
+    }
+
+    void
+    measure(KeyType type, std::size_t batchSize)
+    {
+        auto const items = makeSigned(type, batchSize);
+        std::vector<SignatureCheck> checks;
+        checks.reserve(batchSize);
+        for (auto const& item : items)
+            checks.push_back(
+                {item.publicKey, makeSlice(item.message), item.signature});
+
+        std::size_t valid = 0;
+        auto const start = clock_type::now();
+        for (std::size_t n = 0; n < signatures; n += batchSize)
+        {
+            for (bool const result : verifyBatch(checks))
+                valid += result;
+        }
+        report(
+            std::string("verifyBatch ") + to_string(type),
+            batchSize,
+            clock_type::now() - start);
+        BEAST_EXPECT(valid == signatures);
+
+        if (type != KeyType::ed25519)
+            return;
+
+        // The batch equation of ed25519-donna, which verifyBatch does not
+        // use, for comparison.
+        std::vector<unsigned char const*> m;
+        std::vector<std::size_t> mlen;
+        std::vector<unsigned char const*> pk;
+        std::vector<unsigned char const*> rs;
+        for (auto const& item : items)
+        {
+            m.push_back(
+                reinterpret_cast<unsigned char const*>(item.message.data()));
+            mlen.push_back(item.message.size());
+            // Skip the 0xED prefix
+            pk.push_back(item.publicKey.data() + 1);
+            rs.push_back(item.signature.data());
+        }
+        std::vector<int> results(batchSize);
+        valid = 0;
+        auto const batchStart = clock_type::now();
+        for (std::size_t n = 0; n < signatures; n += batchSize)
+        {
+            ed25519_sign_open_batch(
+                m.data(),
+                mlen.data(),
+                pk.data(),
+                rs.data(),
+                batchSize,
+                results.data());
+            for (int const result : results)
+                valid += result;
+        }
+        report(
+            "ed25519_sign_open_batch",
+            batchSize,
+            clock_type::now() - batchStart);
+        BEAST_EXPECT(valid == signatures);
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("Per-signature cost");
+        for (auto const type : {KeyType::ed25519, KeyType::secp256k1})
+        {
+            for (std::size_t const batchSize : {1, 16, 64, 256})
+                measure(type, batchSize);
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(VerifyBatch, protocol, ripple);
+
+}  // namespace ripple
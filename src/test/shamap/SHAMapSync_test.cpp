@@ -85,8 +85,13 @@ public:
     }
 
     void
-    run() override
+    testSync(std::size_t threads)
     {
+        if (threads > 1)
+            testcase("parallel sync");
+        else
+            testcase("sync");
+
         using namespace beast::severities;
         test::SuiteJournal journal("SHAMapSync_test", *this);
 
@@ -149,7 +154,8 @@ public:
             f.clock().advance(std::chrono::seconds(1));
 
             // get the list of nodes we know we need
-            auto nodesMissing = destination.getMissingNodes(2048, nullptr);
+            auto nodesMissing =
+                destination.getMissingNodes(2048, nullptr, threads);
 
             if (nodesMissing.empty())
                 break;
@@ -199,6 +205,13 @@ public:
         log << "Checking destination invariants..." << std::endl;
         destination.invariants();
     }
+
+    void
+    run() override
+    {
+        testSync(1);
+        testSync(4);
+    }
 };
 
 BEAST_DEFINE_TESTSUITE(SHAMapSync, shamap, ripple);
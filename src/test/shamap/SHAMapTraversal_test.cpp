@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2021 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/protocol/Serializer.h>
+#include <ripple/shamap/SHAMap.h>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace tests {
+
+/** Measures how well concurrent readers of one SHAMap scale.
+
+    Every thread walks every leaf of the same map. The "cold" walk starts
+    from a freshly fetched root, so the threads race to load and hook up
+    the same children; the "warm" walks then only follow child pointers
+    that are already in place.
+*/
+class SHAMapTraversal_test : public beast::unit_test::suite
+{
+    static constexpr int items = 100000;
+    static constexpr int warmPasses = 4;
+
+    void
+    measure(TestNodeFamily& f, SHAMapHash const& root, std::size_t threads)
+    {
+        using namespace std::chrono;
+
+        SHAMap map(SHAMapType::FREE, root.as_uint256(), f);
+        if (!BEAST_EXPECT(map.fetchRoot(root, nullptr)))
+            return;
+        map.setImmutable();
+
+        auto walk = [&](int passes) {
+            std::atomic<std::size_t> leaves{0};
+            auto const start = steady_clock::now();
+            std::vector<std::thread> workers;
+            workers.reserve(threads);
+            for (std::size_t t = 0; t < threads; ++t)
+            {
+                workers.emplace_back([&] {
+                    std::size_t n = 0;
+                    for (int i = 0; i < passes; ++i)
+                    {
+                        for (auto const& item : map)
+                        {
+                            (void)item;
+                            ++n;
+                        }
+                    }
+                    leaves += n;
+                });
+            }
+            for (auto& w : workers)
+                w.join();
+            BEAST_EXPECT(leaves == threads * passes * items);
+            return duration_cast<milliseconds>(steady_clock::now() - start);
+        };
+
+        auto const cold = walk(1);
+        auto const warm = walk(warmPasses);
+
+        log << std::setw(2) << threads << " threads: cold " << std::setw(5)
+            << cold.count() << "ms, warm " << std::setw(5) << warm.count()
+            << "ms" << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("concurrent traversal");
+
+        test::SuiteJournal journal("SHAMapTraversal_test", *this);
+        TestNodeFamily f(journal);
+
+        beast::xor_shift_engine eng;
+        SHAMap source(SHAMapType::FREE, f);
+        for (int i = 0; i < items; ++i)
+        {
+            Serializer s;
+            for (int d = 0; d < 3; ++d)
+                s.add32(rand_int<std::uint32_t>(eng));
+            BEAST_EXPECT(source.addItem(
+                SHAMapNodeType::tnACCOUNT_STATE,
+                SHAMapItem{s.getSHA512Half(), s.slice()}));
+        }
+        source.flushDirty(hotACCOUNT_NODE);
+        auto const root = source.getHash();
+
+        for (std::size_t threads : {1, 2, 4, 8, 16})
+        {
+            // Make every cold walk load its nodes from the database
+            f.getTreeNodeCache(0)->reset();
+            measure(f, root, threads);
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(SHAMapTraversal, ripple_app, ripple);
+
+}  // namespace tests
+}  // namespace ripple
@@ -21,8 +21,11 @@
 #include <ripple/basics/Buffer.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/protocol/digest.h>
 #include <ripple/shamap/SHAMap.h>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <test/shamap/common.h>
 #include <test/unit_test/SuiteJournal.h>
 
@@ -323,6 +326,203 @@ public:
                 --h;
             }
         }
+
+        if (backed)
+        {
+            testcase("iterate cold backed");
+
+            tests::TestNodeFamily tf{journal};
+            SHAMap map{SHAMapType::FREE, tf};
+            std::vector<uint256> keys;
+            for (int i = 0; i < 3000; ++i)
+            {
+                keys.push_back(sha512Half(i));
+                map.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    SHAMapItem{keys.back(), IntToVUC(i)});
+            }
+            map.flushDirty(hotACCOUNT_NODE);
+            std::sort(keys.begin(), keys.end());
+
+            // Every node is read from the database, mostly read ahead
+            tf.getTreeNodeCache(0)->reset();
+            SHAMap cold{SHAMapType::FREE, map.getHash().as_uint256(), tf};
+            BEAST_EXPECT(cold.fetchRoot(map.getHash(), nullptr));
+            cold.setImmutable();
+
+            auto key = keys.begin();
+            for (auto const& item : cold)
+            {
+                if (!BEAST_EXPECT(key != keys.end()))
+                    break;
+                BEAST_EXPECT(item.key() == *key++);
+            }
+            BEAST_EXPECT(key == keys.end());
+
+            tf.getTreeNodeCache(0)->reset();
+            SHAMap visited{SHAMapType::FREE, map.getHash().as_uint256(), tf};
+            BEAST_EXPECT(visited.fetchRoot(map.getHash(), nullptr));
+            std::size_t leaves = 0;
+            visited.visitLeaves([&leaves](auto const&) { ++leaves; });
+            BEAST_EXPECT(leaves == keys.size());
+        }
+
+        if (backed)
+            testcase("parallel flush backed");
+        else
+            testcase("parallel flush unbacked");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap serial{SHAMapType::FREE, tf};
+            SHAMap parallel{SHAMapType::FREE, tf};
+            if (!backed)
+            {
+                serial.setUnbacked();
+                parallel.setUnbacked();
+            }
+
+            auto add = [this](SHAMap& map, int first, int last) {
+                for (int i = first; i < last; ++i)
+                    BEAST_EXPECT(map.addItem(
+                        SHAMapNodeType::tnACCOUNT_STATE,
+                        SHAMapItem{sha512Half(i), IntToVUC(i)}));
+            };
+
+            add(serial, 0, 5000);
+            add(parallel, 0, 5000);
+            int const flushed = serial.flushDirty(hotACCOUNT_NODE);
+            BEAST_EXPECT(flushed > 5000);
+            BEAST_EXPECT(parallel.flushDirty(hotACCOUNT_NODE, 8) == flushed);
+            BEAST_EXPECT(parallel.getHash() == serial.getHash());
+            parallel.invariants();
+
+            // Modify only some of the subtrees of mutable snapshots
+            auto const serialCopy = serial.snapShot(true);
+            auto const parallelCopy = parallel.snapShot(true);
+            for (auto const& map : {serialCopy, parallelCopy})
+            {
+                add(*map, 5000, 5010);
+                for (int i = 0; i < 20; ++i)
+                    BEAST_EXPECT(map->delItem(sha512Half(i)));
+            }
+            BEAST_EXPECT(
+                parallelCopy->flushDirty(hotACCOUNT_NODE, 8) ==
+                serialCopy->flushDirty(hotACCOUNT_NODE));
+            BEAST_EXPECT(parallelCopy->getHash() == serialCopy->getHash());
+            BEAST_EXPECT(parallelCopy->getHash() != serial.getHash());
+            parallelCopy->invariants();
+        }
+
+        if (backed)
+            testcase("parallel compare backed");
+        else
+            testcase("parallel compare unbacked");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap map{SHAMapType::FREE, tf};
+            if (!backed)
+                map.setUnbacked();
+
+            for (int i = 0; i < 3000; ++i)
+                map.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    SHAMapItem{sha512Half(i), IntToVUC(i)});
+            map.flushDirty(hotACCOUNT_NODE);
+
+            auto const other = map.snapShot(true);
+            for (int i = 0; i < 3000; i += 7)
+                BEAST_EXPECT(other->delItem(sha512Half(i)));
+            for (int i = 1; i < 3000; i += 11)
+                BEAST_EXPECT(other->updateGiveItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    std::make_shared<SHAMapItem const>(
+                        sha512Half(i), IntToVUC(i + 1))));
+            for (int i = 3000; i < 3100; ++i)
+                BEAST_EXPECT(other->addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    SHAMapItem{sha512Half(i), IntToVUC(i)}));
+            other->flushDirty(hotACCOUNT_NODE);
+            other->setImmutable();
+            map.setImmutable();
+
+            auto same = [](SHAMap::Delta const& a, SHAMap::Delta const& b) {
+                return std::equal(
+                    a.begin(),
+                    a.end(),
+                    b.begin(),
+                    b.end(),
+                    [](auto const& x, auto const& y) {
+                        return x.first == y.first &&
+                            x.second.first == y.second.first &&
+                            x.second.second == y.second.second;
+                    });
+            };
+
+            // The results must match even when maxCount cuts the walk short
+            for (int maxCount : {1, 2, 7, 100, 500, 1000000})
+            {
+                for (auto [a, b] :
+                     {std::pair{&map, other.get()},
+                      std::pair{other.get(), &map}})
+                {
+                    SHAMap::Delta serial;
+                    SHAMap::Delta parallel;
+                    bool const complete = a->compare(*b, serial, maxCount);
+                    BEAST_EXPECT(
+                        a->compare(*b, parallel, maxCount, 8) == complete);
+                    BEAST_EXPECT(complete == (maxCount == 1000000));
+                    BEAST_EXPECT(same(serial, parallel));
+                }
+            }
+        }
+
+        if (backed)
+            testcase("parallel visit backed");
+        else
+            testcase("parallel visit unbacked");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap map{SHAMapType::FREE, tf};
+            if (!backed)
+                map.setUnbacked();
+
+            for (int i = 0; i < 3000; ++i)
+                map.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    SHAMapItem{sha512Half(i), IntToVUC(i)});
+            map.flushDirty(hotACCOUNT_NODE);
+            map.setImmutable();
+
+            std::vector<SHAMapHash> serial;
+            map.visitNodes([&](SHAMapTreeNode& node) {
+                serial.push_back(node.getHash());
+                return true;
+            });
+
+            std::mutex mutex;
+            std::vector<SHAMapHash> parallel;
+            map.visitNodes(
+                [&](SHAMapTreeNode& node) {
+                    std::lock_guard lock(mutex);
+                    parallel.push_back(node.getHash());
+                    return true;
+                },
+                8);
+
+            std::sort(serial.begin(), serial.end());
+            std::sort(parallel.begin(), parallel.end());
+            BEAST_EXPECT(serial.size() > 3000);
+            BEAST_EXPECT(serial == parallel);
+
+            // Stopping in one subtree stops them all
+            std::atomic<int> visited{0};
+            map.visitNodes(
+                [&](SHAMapTreeNode&) { return ++visited < 100; }, 8);
+            BEAST_EXPECT(visited < 200);
+        }
     }
 };
 